@@ -29,6 +29,7 @@ from typing import Optional
 from pyeclib.cli import bench
 from pyeclib.cli import check
 from pyeclib.cli import list as list_cli
+from pyeclib.cli import scan
 from pyeclib.cli import verify
 from pyeclib.cli import version
 
@@ -71,6 +72,10 @@ def main(args: Optional[list[str]] = None) -> NoReturn:
     bench_parser.set_defaults(func=bench.bench_command)
     bench.add_bench_args(bench_parser)
 
+    scan_parser = subparsers.add_parser("scan", help=scan.scan_description)
+    scan_parser.set_defaults(func=scan.scan_command)
+    scan.add_scan_args(scan_parser)
+
     parsed_args = parser.parse_args(args)
     if parsed_args.func is None:
         parser.error(
@@ -22,81 +22,701 @@
 # THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 import argparse
+import csv
+import itertools
+import json
+import math
 import os
 import random
+import sys
+import threading
 import time
+from typing import Any
+from typing import Callable
+from typing import NamedTuple
 
 from pyeclib import cli
 from pyeclib import ec_iface
 
+PERCENTILES = (("p50", 0.5), ("p99", 0.99), ("p999", 0.999))
+
+OPERATIONS = (
+    "encode",
+    "decode",
+    "reconstruct",
+    "decode_range",
+    "fragments_needed",
+    "segment_info",
+)
+
+# --sweep parameter -> attribute of the parsed arguments
+SWEEP_PARAMS = {
+    "ec_type": "ec_type",
+    "k": "n_data",
+    "m": "n_parity",
+    "local_parity": "local_parity",
+    "segment_size": "segment_size",
+    "unavailable": "unavailable",
+    "op": "op",
+}
+
+# What identifies a result when comparing against a baseline
+RESULT_KEY = (
+    "ec_type",
+    "k",
+    "m",
+    "local_parity",
+    "unavailable",
+    "op",
+    "threads",
+    "batch",
+    "segment_size",
+)
+
+
+class Config(NamedTuple):
+    ec_type: str
+    k: int
+    m: int
+    local_parity: int
+    segment_size: int
+    unavailable: int
+
+
+class Operation(NamedTuple):
+    call: Callable[[int], object]
+    # Payload bytes processed per call; 0 for metadata-only operations
+    bytes_per_call: int
+    segments_per_call: int = 1
+
 
 def add_bench_args(parser: argparse.ArgumentParser) -> None:
     parser.add_argument("-e", "--encode", action="store_true")
     parser.add_argument("-d", "--decode", action="store_true")
     cli.add_instance_args(parser, default_segment_size=2**20)
     parser.add_argument("--iterations", "-i", type=int, default=200)
+    parser.add_argument(
+        "--warmup",
+        "-w",
+        metavar="N",
+        type=int,
+        default=10,
+        help="run N untimed operations per thread before measuring",
+    )
+    parser.add_argument(
+        "--threads",
+        "-t",
+        metavar="N",
+        type=int,
+        default=1,
+        help="scale from 1 up to N threads sharing one instance",
+    )
+    parser.add_argument(
+        "--batch",
+        "-b",
+        metavar="N",
+        type=int,
+        default=1,
+        help="encode/decode N segments per call using encode_many and "
+        "decode_many",
+    )
+    parser.add_argument(
+        "--sweep",
+        metavar="PARAM=V1,V2,...",
+        action="append",
+        default=[],
+        help="benchmark every combination of these values; PARAM is one of "
+        f"{', '.join(SWEEP_PARAMS)}; op is one of {', '.join(OPERATIONS)}",
+    )
+    parser.add_argument(
+        "--overhead",
+        action="store_true",
+        help="measure how much time encode, decode and reconstruct spend in "
+        "the binding rather than in liberasurecode, against a native loop "
+        "run inside the extension",
+    )
+    parser.add_argument(
+        "--json",
+        metavar="FILE",
+        help="also write the results to FILE as JSON",
+    )
+    parser.add_argument(
+        "--csv",
+        metavar="FILE",
+        help="also write the results to FILE as CSV",
+    )
+    parser.add_argument(
+        "--compare",
+        metavar="BASELINE",
+        help="compare against results previously written with --json and "
+        "exit 1 on regressions",
+    )
+    parser.add_argument(
+        "--tolerance",
+        metavar="PERCENT",
+        type=float,
+        default=10.0,
+        help="how much worse than the baseline a result may be before it "
+        "counts as a regression",
+    )
+
+
+def parse_sweep(args: argparse.Namespace) -> dict[str, list[Any]]:
+    """
+    Return the values to benchmark for each parameter: those given with
+    --sweep, or else the single value from the regular options.
+    """
+    ops = []
+    if args.encode or not args.decode:
+        ops.append("encode")
+    if args.decode or not args.encode:
+        ops.append("decode")
+    grid: dict[str, list[Any]] = {
+        "ec_type": args.ec_type,
+        "k": [args.n_data],
+        "m": [args.n_parity],
+        "local_parity": [args.local_parity],
+        "segment_size": [args.segment_size],
+        "unavailable": [args.unavailable],
+        "op": ops,
+    }
+    for spec in args.sweep:
+        name, sep, values = spec.partition("=")
+        if not sep or name not in SWEEP_PARAMS:
+            raise SystemExit(f"invalid --sweep {spec!r}")
+        items = [v for v in values.split(",") if v]
+        if name == "ec_type":
+            grid[name] = cli.expand_ec_types(items)
+        elif name == "op":
+            unknown = set(items) - set(OPERATIONS)
+            if unknown:
+                raise SystemExit(f"unknown op {', '.join(sorted(unknown))}")
+            grid[name] = items
+        else:
+            grid[name] = [int(v) for v in items]
+    return grid
+
+
+def thread_counts(max_threads: int) -> list[int]:
+    counts = []
+    n = 1
+    while n < max_threads:
+        counts.append(n)
+        n *= 2
+    counts.append(max(max_threads, 1))
+    return counts
+
+
+def percentile(sorted_samples: list[int], fraction: float) -> int:
+    """
+    Nearest-rank percentile of an already sorted, non-empty list.
+    """
+    rank = max(math.ceil(fraction * len(sorted_samples)), 1)
+    return sorted_samples[min(rank, len(sorted_samples)) - 1]
+
+
+def run_threads(
+    threads: int,
+    iterations: int,
+    op: Callable[[int], object],
+    warmup: int = 0,
+) -> tuple[float, list[int]]:
+    """
+    Call ``op(i)`` for each ``i`` in ``range(iterations)`` in each of
+    ``threads`` threads, after ``warmup`` untimed calls per thread.
+
+    :returns: the wall-clock time it took, in seconds, and the latency of
+              every call, in nanoseconds
+    """
+    samples: list[list[int]] = [[] for _ in range(max(threads, 1))]
+    clock = time.perf_counter_ns
+
+    def measure(latencies: list[int]) -> None:
+        record = latencies.append
+        for i in range(iterations):
+            start = clock()
+            op(i)
+            record(clock() - start)
+
+    if threads <= 1:
+        for i in range(warmup):
+            op(i)
+        start = time.perf_counter()
+        measure(samples[0])
+        return time.perf_counter() - start, samples[0]
+
+    barrier = threading.Barrier(threads + 1)
+
+    def worker(latencies: list[int]) -> None:
+        for i in range(warmup):
+            op(i)
+        barrier.wait()
+        measure(latencies)
+
+    workers = [
+        threading.Thread(target=worker, args=(latencies,))
+        for latencies in samples
+    ]
+    for t in workers:
+        t.start()
+    barrier.wait()
+    start = time.perf_counter()
+    for t in workers:
+        t.join()
+    return time.perf_counter() - start, [s for lat in samples for s in lat]
+
+
+def make_operations(
+    instance: ec_iface.ECDriver,
+    config: Config,
+    view: memoryview,
+    batch: int,
+) -> dict[str, Operation]:
+    """
+    Build the benchmarked callables for one instance.  Each takes the
+    iteration number, used to vary the input from call to call.
+    """
+    ec_type, k, m, local_parity, segment_size, unavailable = config
+    frags = instance.encode(view[:segment_size])
+
+    def pick_frags() -> list[bytes]:
+        data_frags = random.sample(frags[:k], k - unavailable)
+        if ec_type.startswith("flat_xor"):
+            # The math is actually more complicated than this, but ...
+            parity_frags = frags[k:]
+        elif ec_type == "isa_l_rs_lrc":
+            parity_frags = random.sample(
+                frags[k:], unavailable + local_parity - 1
+            )
+        else:
+            parity_frags = random.sample(frags[k:], unavailable)
+        return data_frags + parity_frags
+
+    def pick_lost() -> list[int]:
+        return random.sample(range(k + m), unavailable)
+
+    def encode(i: int) -> None:
+        instance.encode(view[i : i + segment_size])
+
+    def encode_batch(i: int) -> None:
+        instance.encode_many(
+            [view[j : j + segment_size] for j in range(i, i + batch)]
+        )
+
+    def decode(i: int) -> None:
+        instance.decode(pick_frags())
+
+    def decode_batch(i: int) -> None:
+        instance.decode_many([pick_frags() for _ in range(batch)])
 
+    range_len = min(segment_size, 4096)
 
-def bench_command(args: argparse.Namespace) -> None:
+    def decode_range(i: int) -> None:
+        start = random.randrange(segment_size - range_len + 1)
+        instance.decode(pick_frags(), [(start, start + range_len - 1)])
+
+    # Not every erasure pattern can be rebuilt with every code, so time
+    # the reconstruction of a few patterns known to work
+    rebuildable = []
+    for _ in range(64):
+        lost = pick_lost()
+        available = [f for i, f in enumerate(frags) if i not in lost]
+        try:
+            instance.reconstruct(available, lost[:1])
+        except ec_iface.ECDriverError:
+            continue
+        rebuildable.append((available, lost[:1]))
+        if len(rebuildable) == 8:
+            break
+
+    def reconstruct(i: int) -> None:
+        instance.reconstruct(*rebuildable[i % len(rebuildable)])
+
+    def fragments_needed(i: int) -> None:
+        instance.fragments_needed(pick_lost())
+
+    def segment_info(i: int) -> None:
+        instance.get_segment_info(segment_size * 10 + i, segment_size)
+
+    ops = {
+        "encode": Operation(
+            encode_batch if batch > 1 else encode, segment_size * batch, batch
+        ),
+        "decode": Operation(
+            decode_batch if batch > 1 else decode, segment_size * batch, batch
+        ),
+        "decode_range": Operation(decode_range, range_len),
+        "fragments_needed": Operation(fragments_needed, 0),
+        "segment_info": Operation(segment_info, 0),
+    }
+    if rebuildable:
+        ops["reconstruct"] = Operation(reconstruct, len(frags[0]))
+    return ops
+
+
+def make_baselines(
+    instance: ec_iface.ECDriver,
+    config: Config,
+    view: memoryview,
+) -> dict[str, tuple[Callable[[int], object], str, Any, int]]:
+    """
+    Build, for each operation that has a native baseline, a callable that
+    runs it through the binding along with the bench_native() arguments that
+    run it straight against liberasurecode, all with the same fixed input.
+    """
+    k, unavailable = config.k, config.unavailable
+    data = view[: config.segment_size]
+    frags = instance.encode(data)
+    baselines: dict[str, tuple[Callable[[int], object], str, Any, int]] = {
+        "encode": (lambda i: instance.encode(data), "encode", data, 0),
+    }
+
+    # Make the library do some actual decoding
+    available = frags[unavailable:]
+    try:
+        instance.decode(available)
+    except ec_iface.ECDriverError:
+        pass
+    else:
+        baselines["decode"] = (
+            lambda i: instance.decode(available),
+            "decode",
+            available,
+            0,
+        )
+
+    lost = min(unavailable, k) - 1 if unavailable else 0
+    others = [f for i, f in enumerate(frags) if i != lost]
+    try:
+        instance.reconstruct(others, [lost])
+    except ec_iface.ECDriverError:
+        pass
+    else:
+        baselines["reconstruct"] = (
+            lambda i: instance.reconstruct(others, [lost]),
+            "reconstruct",
+            others,
+            lost,
+        )
+    return baselines
+
+
+def measure_overhead(
+    instance: ec_iface.ECDriver,
+    call: Callable[[int], object],
+    native_args: tuple[str, Any, int],
+    iterations: int,
+    warmup: int,
+    rounds: int = 3,
+) -> tuple[float, float, list[int]]:
+    """
+    Time ``call`` and its native baseline, single-threaded, alternating
+    between them for a few rounds and keeping the best round of each so
+    that noise doesn't swamp small differences.
+
+    :returns: the time per call through the binding and natively, in
+              microseconds, and the latency of every call through the binding
+              in its best round
+    """
+    native = instance.ec_lib_reference.bench_native
+    op, payload, index = native_args
+    native(op, payload, warmup, index)
+    best_dt = best_native_ns = math.inf
+    best_samples: list[int] = []
+    for _ in range(rounds):
+        dt, samples = run_threads(1, iterations, call, warmup)
+        if dt < best_dt:
+            best_dt, best_samples = dt, samples
+        best_native_ns = min(
+            best_native_ns, native(op, payload, iterations, index)
+        )
+    return (
+        best_dt * 1e6 / iterations,
+        best_native_ns / 1e3 / iterations,
+        best_samples,
+    )
+
+
+def format_overhead(result: dict[str, Any], name: str) -> str:
+    percent = 100.0 * result["overhead_us"] / result["native_us"]
+    return (
+        f"{name} ({result['op']}): native {result['native_us']:.1f}us/call, "
+        f"binding {result['overhead_us']:+.2f}us/call ({percent:+.1f}%), "
+        f"{result['overhead_ns_per_byte']:+.3f}ns/byte"
+    )
+
+
+def format_result(result: dict[str, Any], swept: list[str]) -> str:
+    name = result["ec_type"]
+    for param in swept:
+        if param not in ("ec_type", "op"):
+            name += f" {param}={result[param]}"
+    label = result["op"]
+    if result["batch"] > 1:
+        label += f", batch {result['batch']}"
+    if result["max_threads"] > 1:
+        label += f", {result['threads']}T"
+    latencies = ", ".join(
+        f"{pct} {result[pct + '_us']:.1f}us" for pct, _ in PERCENTILES
+    )
+    if result["mb_per_s"]:
+        rate = (
+            f"{result['mb_per_s']:.1f}MB/s, "
+            f"{result['us_per_segment']:.1f}us/segment"
+        )
+    else:
+        rate = f"{result['ops_per_s']:.0f}ops/s"
+    return f"{name} ({label}): {rate}, {latencies}"
+
+
+def print_fastest(results: list[dict[str, Any]]) -> None:
+    """
+    For each workload, i.e. operation, segment size, number of unavailable
+    fragments and thread count, say which of the benchmarked policies did
+    best.
+    """
+    fastest: dict[tuple[str, int, int, int], dict[str, Any]] = {}
+    for result in results:
+        key = (
+            result["op"],
+            result["segment_size"],
+            result["unavailable"],
+            result["threads"],
+        )
+        if key not in fastest or (
+            result["ops_per_s"] > fastest[key]["ops_per_s"]
+        ):
+            fastest[key] = result
+    print("Fastest:")
+    for (op, segment_size, unavailable, threads), result in fastest.items():
+        policy = f"{result['ec_type']} k={result['k']} m={result['m']}"
+        if result["ec_type"] == "isa_l_rs_lrc":
+            policy += f" local_parity={result['local_parity']}"
+        print(
+            f"  {op}, {segment_size}-byte segments, {unavailable} "
+            f"unavailable, {threads}T: {policy}"
+        )
+
+
+def compare_results(
+    results: list[dict[str, Any]],
+    baseline: list[dict[str, Any]],
+    tolerance: float,
+) -> int:
+    """
+    Print how ``results`` compare to ``baseline`` and return the number of
+    regressions: lower throughput or higher p99 latency, by more than
+    ``tolerance`` percent.
+    """
+    by_key = {tuple(r[k] for k in RESULT_KEY): r for r in baseline}
+    regressions = 0
+    for result in results:
+        base = by_key.get(tuple(result[k] for k in RESULT_KEY))
+        if base is None:
+            continue
+        throughput = 100.0 * (result["ops_per_s"] / base["ops_per_s"] - 1)
+        p99 = 100.0 * (result["p99_us"] / max(base["p99_us"], 1e-9) - 1)
+        line = (
+            f"{result['ec_type']} k={result['k']} m={result['m']} "
+            f"({result['op']}, {result['threads']}T): "
+            f"throughput {throughput:+.1f}%, p99 {p99:+.1f}%"
+        )
+        if throughput < -tolerance or p99 > tolerance:
+            regressions += 1
+            print(f"\x1b[1;91m{line} REGRESSION\x1b[0m")
+        else:
+            print(line)
+    return regressions
+
+
+def usable_cpus() -> int:
+    """
+    Number of CPUs this process may run on, to put thread counts in context.
+    """
+    if hasattr(os, "sched_getaffinity"):
+        return len(os.sched_getaffinity(0))
+    return os.cpu_count() or 1
+
+
+def bench_command(args: argparse.Namespace) -> int:
     args.ec_type = cli.expand_ec_types(args.ec_type)
-    data = os.urandom(args.segment_size + args.iterations)
-    width = max(len(ec_type) for ec_type in args.ec_type)
-    print(
-        f"Using {args.n_data} data + {args.n_parity} parity with "
-        f"{args.unavailable} unavailable frags"
+    grid = parse_sweep(args)
+    swept = [param for param, values in grid.items() if len(values) > 1]
+    data = os.urandom(
+        max(grid["segment_size"])
+        + max(args.iterations, args.warmup)
+        + args.batch
     )
+    # Slicing a memoryview doesn't copy, so only the library is measured
+    view = memoryview(data)
+    width = max(len(ec_type) for ec_type in grid["ec_type"])
+    results: list[dict[str, Any]] = []
+    cpus = usable_cpus()
+    if not args.sweep:
+        print(
+            f"Using {args.n_data} data + {args.n_parity} parity with "
+            f"{args.unavailable} unavailable frags"
+        )
+    if args.overhead:
+        print(
+            "Native baseline: liberasurecode called in a loop from inside "
+            "pyeclib_c, in this process; not a standalone C program"
+        )
 
-    for ec_type in args.ec_type:
+    for ec_type in grid["ec_type"]:
         if ec_type not in ec_iface.ALL_EC_TYPES:
             print(f"{ec_type:<{width}} unknown")
             continue
         if ec_type not in ec_iface.VALID_EC_TYPES:
             print(f"{ec_type:<{width}} not available")
             continue
-        try:
-            instance = ec_iface.ECDriver(
-                ec_type=ec_type,
-                k=args.n_data,
-                m=args.n_parity,
-                local_parity=args.local_parity,
+        for config in itertools.starmap(
+            Config,
+            itertools.product(
+                [ec_type],
+                grid["k"],
+                grid["m"],
+                grid["local_parity"],
+                grid["segment_size"],
+                grid["unavailable"],
+            ),
+        ):
+            name = " ".join(
+                [ec_type]
+                + [
+                    f"{param}={getattr(config, param)}"
+                    for param in Config._fields[1:]
+                    if param in swept
+                ]
             )
-        except ec_iface.ECDriverError:
-            print(f"{ec_type:<{width}} could not be instantiated")
-            continue
-        frags = instance.encode(data[: args.segment_size])
-
-        if args.encode or not args.decode:
-            start = time.time()
-            for i in range(args.iterations):
-                _ = instance.encode(data[i : i + args.segment_size])
-            dt = time.time() - start
-            mb_encoded = args.iterations * args.segment_size / (2**20)
-            print(f"{ec_type} (encode): {mb_encoded / dt:.1f}MB/s")
-
-        if args.decode or not args.encode:
-            start = time.time()
-            for i in range(args.iterations):
-                data_frags = random.sample(
-                    frags[: args.n_data],
-                    args.n_data - args.unavailable,
+            if config.unavailable > config.m:
+                print(f"{name}: more unavailable frags than parity")
+                continue
+            try:
+                instance = ec_iface.ECDriver(
+                    ec_type=ec_type,
+                    k=config.k,
+                    m=config.m,
+                    local_parity=config.local_parity,
                 )
-                if ec_type.startswith("flat_xor"):
-                    # The math is actually more complicated than this, but ...
-                    parity_frags = frags[args.n_data :]
-                elif ec_type == "isa_l_rs_lrc":
-                    parity_frags = random.sample(
-                        frags[args.n_data :],
-                        args.unavailable + args.local_parity - 1,
+                ops = make_operations(instance, config, view, args.batch)
+                baselines = make_baselines(instance, config, view)
+            except ec_iface.ECDriverError:
+                print(f"{name} could not be instantiated")
+                continue
+
+            for op_name in grid["op"]:
+                if args.overhead:
+                    if op_name not in baselines:
+                        print(f"{name} ({op_name}): no native baseline")
+                        continue
+                    call, *native_args = baselines[op_name]
+                    binding_us, native_us, samples = measure_overhead(
+                        instance,
+                        call,
+                        tuple(native_args),
+                        args.iterations,
+                        args.warmup,
                     )
-                else:
-                    parity_frags = random.sample(
-                        frags[args.n_data :],
-                        args.unavailable,
+                    samples.sort()
+                    bytes_per_call = (
+                        config.segment_size
+                        if op_name != "reconstruct"
+                        else len(native_args[1][0])
                     )
-                _ = instance.decode(data_frags + parity_frags)
-            dt = time.time() - start
-            mb_encoded = args.iterations * args.segment_size / (2**20)
-            print(f"{ec_type} (decode): {mb_encoded / dt:.1f}MB/s")
+                    result = {
+                        **config._asdict(),
+                        "op": op_name,
+                        "threads": 1,
+                        "batch": 1,
+                        "iterations": args.iterations,
+                        "ops_per_s": 1e6 / binding_us,
+                        "binding_us": binding_us,
+                        "native_us": native_us,
+                        "overhead_us": binding_us - native_us,
+                        "overhead_ns_per_byte": (
+                            (binding_us - native_us) * 1e3 / bytes_per_call
+                        ),
+                    }
+                    for pct_name, fraction in PERCENTILES:
+                        result[pct_name + "_us"] = (
+                            percentile(samples, fraction) / 1e3
+                        )
+                    results.append(result)
+                    print(format_overhead(result, name))
+                    continue
+
+                if op_name not in ops:
+                    print(f"{name} ({op_name}): not supported")
+                    continue
+                op = ops[op_name]
+                for threads in thread_counts(args.threads):
+                    try:
+                        dt, samples = run_threads(
+                            threads, args.iterations, op.call, args.warmup
+                        )
+                    except ec_iface.ECDriverError as e:
+                        print(f"{name} ({op_name}): failed: {e}")
+                        break
+                    samples.sort()
+                    calls = threads * args.iterations
+                    segments = calls * op.segments_per_call
+                    result = {
+                        "ec_type": ec_type,
+                        "k": config.k,
+                        "m": config.m,
+                        "local_parity": config.local_parity,
+                        "unavailable": config.unavailable,
+                        "op": op_name,
+                        "threads": threads,
+                        "max_threads": args.threads,
+                        "batch": args.batch,
+                        "segment_size": config.segment_size,
+                        "iterations": args.iterations,
+                        "ops_per_s": calls / dt,
+                        "mb_per_s": calls * op.bytes_per_call / dt / 2**20,
+                        "us_per_segment": dt * 1e6 / segments,
+                    }
+                    for pct_name, fraction in PERCENTILES:
+                        result[pct_name + "_us"] = (
+                            percentile(samples, fraction) / 1e3
+                            if samples
+                            else 0
+                        )
+                    results.append(result)
+                    line = format_result(result, swept)
+                    if threads > cpus:
+                        # Threads can only time-slice the CPUs they have
+                        line += f" [{cpus} CPU(s): not a scaling result]"
+                    print(line)
+
+    if args.sweep and results and not args.overhead:
+        print_fastest(results)
+
+    if args.json:
+        report = {
+            "pyeclib": ec_iface.__version__,
+            "liberasurecode": ec_iface.LIBERASURECODE_VERSION,
+            "cpus": cpus,
+            "results": results,
+        }
+        with open(args.json, "w") as fp:
+            json.dump(report, fp, indent=2)
+            fp.write("\n")
+
+    if args.csv and results:
+        with open(args.csv, "w", newline="") as fp:
+            writer = csv.DictWriter(fp, fieldnames=list(results[0]))
+            writer.writeheader()
+            writer.writerows(results)
+
+    if args.compare:
+        with open(args.compare) as fp:
+            baseline = json.load(fp)
+        print(f"Compared to {args.compare}:")
+        if compare_results(results, baseline["results"], args.tolerance):
+            return 1
+    return 0
 
 
 bench_description = "benchmark EC schemas"
@@ -106,4 +726,4 @@ if __name__ == "__main__":
     parser = argparse.ArgumentParser(description=bench_description)
     add_bench_args(parser)
     args = parser.parse_args()
-    bench_command(args)
+    sys.exit(bench_command(args))
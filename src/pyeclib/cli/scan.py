@@ -0,0 +1,177 @@
+# Copyright (c) 2025, NVIDIA
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# Redistributions of source code must retain the above copyright notice, this
+# list of conditions and the following disclaimer.
+#
+# Redistributions in binary form must reproduce the above copyright notice,
+# this list of conditions and the following disclaimer in the documentation
+# and/or other materials provided with the distribution.  THIS SOFTWARE IS
+# PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+# OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+# OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN
+# NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+# DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+# (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+# LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+# ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+# THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+import argparse
+import collections
+from concurrent.futures import ThreadPoolExecutor
+import mmap
+import os
+import sys
+import time
+from typing import NamedTuple
+from typing import Optional
+
+from pyeclib import ec_iface
+
+
+class ScanResult(NamedTuple):
+    path: str
+    size: int
+    fragments: int
+    bad_offsets: list[int]
+    # Where parsing gave up, if it did not reach the end of the file
+    stopped_at: Optional[int]
+    seconds: float
+    error: Optional[str] = None
+
+
+def add_scan_args(parser: argparse.ArgumentParser) -> None:
+    parser.add_argument(
+        "-q",
+        "--quiet",
+        action="store_true",
+        help="only report files with problems",
+    )
+    parser.add_argument(
+        "--jobs",
+        "-j",
+        metavar="N",
+        type=int,
+        default=os.cpu_count() or 1,
+        help="scan up to N files at once",
+    )
+    parser.add_argument(
+        "--headers-only",
+        action="store_true",
+        help="skip checksum verification and only walk the fragment headers",
+    )
+    parser.add_argument("files", metavar="FILE", nargs="+")
+
+
+def scan_file(path: str, verify_checksums: bool) -> ScanResult:
+    start = time.time()
+    try:
+        with open(path, "rb") as fp:
+            size = os.fstat(fp.fileno()).st_size
+            if size == 0:
+                # Can't mmap an empty file
+                result = ec_iface.scan_fragments(b"")
+            else:
+                with mmap.mmap(
+                    fp.fileno(), 0, access=mmap.ACCESS_READ
+                ) as buf:
+                    if hasattr(buf, "madvise"):
+                        buf.madvise(mmap.MADV_SEQUENTIAL)
+                    result = ec_iface.scan_fragments(buf, verify_checksums)
+    except OSError as e:
+        return ScanResult(path, 0, 0, [], None, time.time() - start, str(e))
+
+    # All fragments in an archive should come from the same column of the
+    # same policy; anything disagreeing with the majority is suspect.
+    identities = list(
+        zip(
+            result["index"],
+            result["backend_id"],
+            result["backend_version"],
+            result["chksum_type"],
+        )
+    )
+    expected = None
+    if identities:
+        ((expected, _),) = collections.Counter(identities).most_common(1)
+    bad_offsets = [
+        offset
+        for offset, mismatch, identity in zip(
+            result["offset"], result["chksum_mismatch"], identities
+        )
+        if mismatch or identity != expected
+    ]
+    return ScanResult(
+        path,
+        size,
+        len(result["offset"]),
+        bad_offsets,
+        result["scanned"] if result["error"] else None,
+        time.time() - start,
+    )
+
+
+def scan_command(args: argparse.Namespace) -> int:
+    total_bytes = 0
+    total_bad = 0
+    unreadable = 0
+    start = time.time()
+    # scan_fragments() releases the GIL, so threads scan files in parallel
+    with ThreadPoolExecutor(max_workers=max(args.jobs, 1)) as pool:
+        results = pool.map(
+            lambda path: scan_file(path, not args.headers_only), args.files
+        )
+        for result in results:
+            if result.error is not None:
+                unreadable += 1
+                print(f"{result.path}: {result.error}")
+                continue
+            total_bytes += result.size
+            mb = result.size / (2**20)
+            summary = (
+                f"{result.path}: {result.fragments} fragments, {mb:.1f}MB, "
+                f"{mb / max(result.seconds, 1e-9):.1f}MB/s"
+            )
+            problems = []
+            if result.bad_offsets:
+                problems.append(
+                    f"{len(result.bad_offsets)} bad at offsets "
+                    + ", ".join(str(o) for o in result.bad_offsets)
+                )
+            if result.stopped_at is not None:
+                problems.append(
+                    f"unparseable data at offset {result.stopped_at}"
+                )
+            if problems:
+                total_bad += 1
+                print(f"\x1b[91;40m{summary}, {'; '.join(problems)}\x1b[0m")
+            elif not args.quiet:
+                print(f"{summary}, ok")
+    dt = time.time() - start
+
+    if not args.quiet:
+        mb = total_bytes / (2**20)
+        print(
+            f"Scanned {len(args.files)} files, {mb:.1f}MB in {dt:.2f}s: "
+            f"{mb / max(dt, 1e-9):.1f}MB/s"
+        )
+    if unreadable:
+        return 2
+    if total_bad:
+        return 1
+    return 0
+
+
+scan_description = "check fragment archives on disk for corruption"
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description=scan_description)
+    add_scan_args(parser)
+    args = parser.parse_args()
+    sys.exit(scan_command(args))
@@ -31,12 +31,54 @@ from .exceptions import ECInsufficientFragments
 
 import math
 import pyeclib_c
+import threading
+import weakref
 from typing import Any
+from typing import Callable
 from typing import Collection
+from typing import TYPE_CHECKING
+
+if TYPE_CHECKING:
+    from typing_extensions import Buffer
 
 NO_CHECKSUM = PyECLib_FRAGHDRCHKSUM_Types.none
 
 
+def _buffer_len(buf: Buffer) -> int:
+    # len() of a memoryview counts items, not bytes
+    if isinstance(buf, (bytes, bytearray)):
+        return len(buf)
+    try:
+        return memoryview(buf).nbytes
+    except TypeError:
+        return -1
+
+
+class _SharedHandle(object):
+    """A native handle together with the number of drivers using it."""
+
+    def __init__(self, handle: pyeclib_c.PyECLibHandle):
+        self.handle = handle
+        self.refs = 0
+
+
+# Native handles shared between drivers, keyed by everything that went into
+# creating them
+_shared_handles: dict[tuple[Any, ...], _SharedHandle] = {}
+_shared_handles_lock = threading.Lock()
+
+
+def _release_shared_handle(key: tuple[Any, ...]) -> None:
+    """Drop one driver's reference, destroying the handle with the last."""
+    with _shared_handles_lock:
+        entry = _shared_handles[key]
+        entry.refs -= 1
+        if entry.refs > 0:
+            return
+        del _shared_handles[key]
+    pyeclib_c.destroy(entry.handle)
+
+
 class ECPyECLibDriver(object):
 
     def __init__(
@@ -48,6 +90,7 @@ class ECPyECLibDriver(object):
         chksum_type: PyECLib_FRAGHDRCHKSUM_Types = NO_CHECKSUM,
         validate: bool = False,
         local_parity: int = 0,
+        shared: bool = False,
     ):
         self.k = k
         self.m = m
@@ -62,7 +105,9 @@ class ECPyECLibDriver(object):
         if self.chksum_type is PyECLib_FRAGHDRCHKSUM_Types.inline_crc32:
             self.inline_chksum = 1
 
-        self._handle: pyeclib_c.PyECLibHandle | None = pyeclib_c.init(
+        self._handle: pyeclib_c.PyECLibHandle | None
+        self._release_shared: Callable[[], None] | None = None
+        init_args = (
             self.k,
             self.m,
             ec_type.value,
@@ -72,6 +117,25 @@ class ECPyECLibDriver(object):
             validate,
             self.local_parity,
         )
+        if not shared:
+            self._handle = pyeclib_c.init(*init_args)
+            return
+
+        # validate only affects how errors are reported during creation
+        key = init_args[:6] + init_args[7:]
+        with _shared_handles_lock:
+            entry = _shared_handles.get(key)
+            if entry is None:
+                entry = _SharedHandle(pyeclib_c.init(*init_args))
+                _shared_handles[key] = entry
+            entry.refs += 1
+        self._handle = entry.handle
+        # Drivers are usually just dropped rather than closed; make sure
+        # that still gives back the reference.  Nothing needs releasing at
+        # interpreter exit.
+        finalizer = weakref.finalize(self, _release_shared_handle, key)
+        finalizer.atexit = False
+        self._release_shared = finalizer
 
     def __repr__(self) -> str:
         return "%s(k=%r, m=%r, hd=%r, ec_type=%r, chksum_type=%r)" % (
@@ -84,7 +148,12 @@ class ECPyECLibDriver(object):
         )
 
     def close(self) -> None:
-        if self._handle is not None:
+        if self._handle is None:
+            return
+        if self._release_shared is not None:
+            # A finalizer only ever runs once, whether called or collected
+            self._release_shared()
+        else:
             pyeclib_c.destroy(self._handle)
         self._handle = None
 
@@ -96,27 +165,54 @@ class ECPyECLibDriver(object):
             )
         return self._handle
 
-    def encode(self, data_bytes: bytes) -> list[bytes]:
-        return pyeclib_c.encode(self.handle, data_bytes)
+    def encode(
+        self, data_bytes: Buffer, zero_copy: bool = False
+    ) -> list[bytes] | list[memoryview]:
+        return pyeclib_c.encode(self.handle, data_bytes, zero_copy)
+
+    def encode_into(
+        self,
+        data_bytes: Buffer,
+        fragment_buffers: list[Buffer],
+    ) -> int:
+        return pyeclib_c.encode_into(
+            self.handle, data_bytes, list(fragment_buffers)
+        )
+
+    def encode_many(
+        self,
+        data_list: Collection[Buffer],
+    ) -> list[list[bytes] | ECDriverError]:
+        return pyeclib_c.encode_many(self.handle, list(data_list))
+
+    def encode_segments(
+        self,
+        data_bytes: Buffer,
+        segment_size: int,
+        threads: int = 1,
+    ) -> list[list[bytes]]:
+        return pyeclib_c.encode_segments(
+            self.handle, data_bytes, segment_size, threads
+        )
 
     def _validate_and_return_fragment_size(
         self,
         method: str,
-        fragments: list[bytes],
+        fragments: list[Buffer],
     ) -> int:
         if len(fragments) == 0:
             raise ECDriverError(
                 f"No fragments payload in ECPyECLibDriver.{method}"
             )
 
-        if len(fragments[0]) == 0:
+        fragment_len = _buffer_len(fragments[0])
+        if fragment_len <= 0:
             raise ECDriverErrorWithPosition(
                 f"Invalid fragment payload in ECPyECLibDriver.{method}", 0
             )
 
-        fragment_len = len(fragments[0])
         for idx, fragment in enumerate(fragments[1:], start=1):
-            if len(fragment) != fragment_len:
+            if _buffer_len(fragment) != fragment_len:
                 raise ECDriverErrorWithPosition(
                     f"Invalid fragment payload in ECPyECLibDriver.{method}",
                     idx + 1,
@@ -125,10 +221,11 @@ class ECPyECLibDriver(object):
 
     def decode(
         self,
-        fragment_payloads: Collection[bytes],
+        fragment_payloads: Collection[Buffer],
         ranges: list[tuple[int, int]] | None = None,
         force_metadata_checks: bool = False,
-    ) -> bytes:
+        zero_copy: bool = False,
+    ) -> bytes | memoryview:
         _fragment_payloads = list(fragment_payloads)
         fragment_len = self._validate_and_return_fragment_size(
             "decode", _fragment_payloads
@@ -145,36 +242,102 @@ class ECPyECLibDriver(object):
             fragment_len,
             ranges,
             force_metadata_checks,
+            zero_copy,
         )
 
     def reconstruct(
         self,
-        fragment_payloads: Collection[bytes],
+        fragment_payloads: Collection[Buffer],
         indexes_to_reconstruct: list[int],
-    ) -> list[bytes]:
+        zero_copy: bool = False,
+    ) -> list[bytes] | list[memoryview]:
         _fragment_payloads = list(fragment_payloads)
         fragment_len = self._validate_and_return_fragment_size(
             "reconstruct", _fragment_payloads
         )
 
-        reconstructed_data = []
-
         # Reconstruct the data, then the parity
         # The parity cannot be reconstructed until
         # after all data is reconstructed
         indexes_to_reconstruct.sort()
-        _indexes_to_reconstruct = indexes_to_reconstruct[:]
 
-        while len(_indexes_to_reconstruct) > 0:
-            index = _indexes_to_reconstruct.pop(0)
-            reconstructed = pyeclib_c.reconstruct(
-                self.handle, _fragment_payloads, fragment_len, index
-            )
-            reconstructed_data.append(reconstructed)
-            _fragment_payloads.append(reconstructed)
+        # One native call marshals the survivors once and feeds each
+        # rebuilt fragment into the next reconstruction
+        reconstructed_data = pyeclib_c.reconstruct_many(
+            self.handle,
+            _fragment_payloads,
+            fragment_len,
+            indexes_to_reconstruct,
+            zero_copy,
+        )
 
         return reconstructed_data
 
+    def decode_into(
+        self,
+        fragment_payloads: Collection[Buffer],
+        output_buffer: Buffer,
+        force_metadata_checks: bool = False,
+    ) -> int:
+        _fragment_payloads = list(fragment_payloads)
+        fragment_len = self._validate_and_return_fragment_size(
+            "decode_into", _fragment_payloads
+        )
+
+        if len(_fragment_payloads) < self.k:
+            raise ECInsufficientFragments(
+                "Not enough fragments given in ECPyECLibDriver.decode_into"
+            )
+
+        return pyeclib_c.decode_into(
+            self.handle,
+            _fragment_payloads,
+            fragment_len,
+            output_buffer,
+            force_metadata_checks,
+        )
+
+    def decode_many(
+        self,
+        fragment_sets: Collection[Collection[Buffer]],
+        force_metadata_checks: bool = False,
+    ) -> list[bytes | ECDriverError]:
+        # Fragment sizes are checked per set in C, so there is no
+        # per-fragment work left to do in Python
+        return pyeclib_c.decode_many(
+            self.handle,
+            [list(fragments) for fragments in fragment_sets],
+            force_metadata_checks,
+        )
+
+    def reconstruct_into(
+        self,
+        fragment_payloads: Collection[Buffer],
+        indexes_to_reconstruct: list[int],
+        output_buffers: list[Buffer],
+    ) -> int:
+        _fragment_payloads = list(fragment_payloads)
+        fragment_len = self._validate_and_return_fragment_size(
+            "reconstruct_into", _fragment_payloads
+        )
+        if len(indexes_to_reconstruct) != len(output_buffers):
+            raise ECDriverError(
+                "Number of output buffers does not match number of "
+                "indexes in ECPyECLibDriver.reconstruct_into"
+            )
+
+        # Same ordering rule as reconstruct(): data before parity, and
+        # each rebuilt fragment is fed back in for the ones after it
+        for index, output in sorted(
+            zip(indexes_to_reconstruct, output_buffers), key=lambda t: t[0]
+        ):
+            pyeclib_c.reconstruct_into(
+                self.handle, _fragment_payloads, fragment_len, index, output
+            )
+            _fragment_payloads.append(memoryview(output)[:fragment_len])
+
+        return fragment_len
+
     def fragments_needed(
         self, reconstruct_indexes: list[int], exclude_indexes: list[int]
     ) -> list[int]:
@@ -187,9 +350,23 @@ class ECPyECLibDriver(object):
         """FIXME - fix this to return a function of HD"""
         return 1
 
+    def stats(self, reset: bool = False) -> pyeclib_c.StatsDict:
+        return pyeclib_c.get_stats(self.handle, reset)
+
+    def bench_native(
+        self,
+        op: str,
+        payload: Buffer | list[Buffer],
+        iterations: int,
+        index: int = 0,
+    ) -> int:
+        return pyeclib_c.bench_native(
+            self.handle, op, payload, iterations, index
+        )
+
     def get_metadata(
         self,
-        fragment: bytes,
+        fragment: Buffer,
         formatted: int = 0,
     ) -> bytes | pyeclib_c.MetadataDict:
         fragment_metadata = pyeclib_c.get_metadata(
@@ -197,13 +374,29 @@ class ECPyECLibDriver(object):
         )
         return fragment_metadata
 
+    def get_metadata_many(
+        self,
+        fragments: Collection[Buffer],
+    ) -> pyeclib_c.MetadataColumnsDict:
+        return pyeclib_c.get_metadata_many(self.handle, list(fragments))
+
     def verify_stripe_metadata(
         self,
-        fragment_metadata_list: list[bytes],
+        fragment_metadata_list: list[Buffer],
     ) -> pyeclib_c.CheckMetadataResultDict:
         success = pyeclib_c.check_metadata(self.handle, fragment_metadata_list)
         return success
 
+    def verify_stripe(
+        self,
+        fragments: Collection[Buffer],
+        threads: int = 1,
+    ) -> pyeclib_c.VerifyStripeResultDict:
+        return pyeclib_c.verify_stripe(self.handle, list(fragments), threads)
+
+    def scrub_stripe(self, fragments: Collection[Buffer]) -> list[int]:
+        return pyeclib_c.scrub_stripe(self.handle, list(fragments))
+
     def get_segment_info(
         self,
         data_len: int,
@@ -214,6 +407,9 @@ class ECPyECLibDriver(object):
         )
         return segment_info
 
+    def stream_encoder(self, segment_size: int) -> pyeclib_c.ECStreamEncoder:
+        return pyeclib_c.ECStreamEncoder(self.handle, segment_size)
+
 
 class ECNullDriver(object):
 
@@ -226,6 +422,7 @@ class ECNullDriver(object):
         chksum_type: PyECLib_FRAGHDRCHKSUM_Types | int | str = "none",
         validate: bool = False,
         local_parity: int = 0,
+        shared: bool = False,
     ):
         self.k = k
         self.m = m
@@ -234,7 +431,25 @@ class ECNullDriver(object):
     def close(self) -> None:
         pass
 
-    def encode(self, data_bytes: bytes) -> None:
+    def encode(self, data_bytes: bytes, zero_copy: bool = False) -> None:
+        pass
+
+    def encode_into(
+        self,
+        data_bytes: bytes,
+        fragment_buffers: list[bytearray],
+    ) -> None:
+        pass
+
+    def encode_many(self, data_list: Collection[bytes]) -> None:
+        pass
+
+    def encode_segments(
+        self,
+        data_bytes: bytes,
+        segment_size: int,
+        threads: int = 1,
+    ) -> None:
         pass
 
     def decode(
@@ -242,6 +457,7 @@ class ECNullDriver(object):
         fragment_payloads: Collection[bytes],
         ranges: list[tuple[int, int]] | None = None,
         force_metadata_checks: bool = False,
+        zero_copy: bool = False,
     ) -> None:
         pass
 
@@ -249,6 +465,30 @@ class ECNullDriver(object):
         self,
         fragment_payloads: Collection[bytes],
         indexes_to_reconstruct: list[int],
+        zero_copy: bool = False,
+    ) -> None:
+        pass
+
+    def decode_into(
+        self,
+        fragment_payloads: Collection[bytes],
+        output_buffer: bytearray,
+        force_metadata_checks: bool = False,
+    ) -> None:
+        pass
+
+    def decode_many(
+        self,
+        fragment_sets: Collection[Collection[bytes]],
+        force_metadata_checks: bool = False,
+    ) -> None:
+        pass
+
+    def reconstruct_into(
+        self,
+        fragment_payloads: Collection[bytes],
+        indexes_to_reconstruct: list[int],
+        output_buffers: list[bytearray],
     ) -> None:
         pass
 
@@ -258,18 +498,46 @@ class ECNullDriver(object):
     def get_metadata(self, fragment: bytes, formatted: int = 0) -> None:
         pass
 
+    def get_metadata_many(self, fragments: Collection[bytes]) -> None:
+        pass
+
     def min_parity_fragments_needed(self) -> None:
         pass
 
+    def stats(self, reset: bool = False) -> None:
+        pass
+
+    def bench_native(
+        self,
+        op: str,
+        payload: bytes | list[bytes],
+        iterations: int,
+        index: int = 0,
+    ) -> None:
+        pass
+
     def verify_stripe_metadata(
         self,
         fragment_metadata_list: list[bytes],
     ) -> None:
         pass
 
+    def verify_stripe(
+        self,
+        fragments: Collection[bytes],
+        threads: int = 1,
+    ) -> None:
+        pass
+
+    def scrub_stripe(self, fragments: Collection[bytes]) -> None:
+        pass
+
     def get_segment_info(self, data_len: int, segment_size: int) -> None:
         pass
 
+    def stream_encoder(self, segment_size: int) -> None:
+        pass
+
 
 #
 # A striping-only driver for EC.  This is
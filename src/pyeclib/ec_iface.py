@@ -23,8 +23,22 @@
 # THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 from __future__ import annotations
+import asyncio
+from concurrent.futures import Executor
+from concurrent.futures import ThreadPoolExecutor
+import functools
+import os
+import threading
+from typing import Any
+from typing import Callable
 from typing import Collection
+from typing import cast
+from typing import Iterable
+from typing import Iterator
+from typing import Literal
+from typing import overload
 from typing import Sequence
+from typing import TYPE_CHECKING
 import warnings
 
 from .enums import PyECLib_EC_Types
@@ -49,6 +63,9 @@ from .utils import positive_int_value
 import pyeclib_c
 from pyeclib_c import get_liberasurecode_version
 
+if TYPE_CHECKING:
+    from typing_extensions import Buffer
+
 
 def check_backend_available(backend_name: str) -> bool:
     from pyeclib_c import check_backend_available
@@ -62,6 +79,41 @@ def check_backend_available(backend_name: str) -> bool:
     return check_backend_available(int_type.value)
 
 
+def scan_fragments(
+    buffer: Buffer,
+    verify_checksums: bool = False,
+) -> pyeclib_c.ScanResultDict:
+    """
+    Walk a buffer of back-to-back fragments, such as a fragment archive.
+
+    No driver is needed: each fragment is located from its own header.  The
+    walk stops at the end of the buffer or at the first fragment whose
+    header is unreadable or that runs past the end of the buffer, since
+    nothing after it can be located.
+
+    The result holds one array.array per field, with entry i describing the
+    i-th fragment found:
+
+    offset, length: where the fragment sits in the buffer
+    index, size, orig_data_size, chksum_type, chksum, chksum_mismatch,
+    backend_id, backend_version: as returned by ECDriver.get_metadata_many()
+
+    plus two ints:
+
+    scanned: the number of bytes walked; equal to len(buffer) unless the
+             walk stopped early
+    error: 0, or the (negative) error code of the fragment that stopped it
+
+    :param buffer: fragments laid end to end
+    :param verify_checksums: also check the header checksums, and for
+                             fragments with an inline CRC32 the payload,
+                             setting chksum_mismatch; this reads every byte
+                             rather than just the headers
+    :returns: a dict of array.array columns plus scanned and error
+    """
+    return pyeclib_c.scan_fragments(buffer, verify_checksums)
+
+
 def PyECLibVersion(z: int, y: int, x: int) -> int:
     return ((z) << 16) + ((y) << 8) + (x)
 
@@ -77,6 +129,23 @@ PYECLIB_MAX_DATA = 32
 PYECLIB_MAX_PARITY = 32
 
 
+# Worker threads for the *_async() methods.  The native calls release the
+# GIL, so these run in parallel with each other and with the event loop.
+_async_executor: ThreadPoolExecutor | None = None
+_async_executor_lock = threading.Lock()
+
+
+def _get_async_executor() -> ThreadPoolExecutor:
+    global _async_executor
+    with _async_executor_lock:
+        if _async_executor is None:
+            _async_executor = ThreadPoolExecutor(
+                max_workers=os.cpu_count() or 1,
+                thread_name_prefix="pyeclib",
+            )
+        return _async_executor
+
+
 # Main ECDriver class
 class ECDriver(object):
     """A driver to encode, decode, and reconstruct erasure-coded data."""
@@ -91,6 +160,7 @@ class ECDriver(object):
         chksum_type: str = "none",
         validate: bool = False,
         local_parity: int = 0,
+        shared: bool = False,
     ):
         """
         :param ec_type: the erasure coding type to use for this driver.
@@ -99,6 +169,12 @@ class ECDriver(object):
         :param chksum_type:
         :param validate: default: False
         :param library_import_str: default: 'pyeclib.core.ECPyECLibDriver'
+        :param shared: reuse the native instance of any other shared driver
+                       created with the same ec_type, k, m, chksum_type
+                       and local_parity, rather than creating a new one.
+                       The instance is destroyed when the last driver
+                       sharing it is closed or garbage collected.
+                       default: False
 
         You must provide either ``ec_type`` or ``library_import_str``;
         typically you just want to use ``ec_type``. See ALL_EC_TYPES for the
@@ -176,6 +252,12 @@ class ECDriver(object):
         #
         # Instantiate EC backend driver
         #
+        # Only pass shared when asked for, so that drivers written before it
+        # existed keep working.
+        self.shared = bool(shared)
+        extra_args: dict[str, Any] = {}
+        if self.shared:
+            extra_args["shared"] = True
         self.ec_lib_reference = create_instance(
             self.library_import_str,
             k=self.k,
@@ -185,6 +267,7 @@ class ECDriver(object):
             chksum_type=self.chksum_type,
             validate=int(self.validate),
             local_parity=self.local_parity,
+            **extra_args,
         )
 
         #
@@ -229,44 +312,233 @@ class ECDriver(object):
     def close(self) -> None:
         self.ec_lib_reference.close()
 
-    def encode(self, data_bytes: bytes) -> list[bytes]:
+    @overload
+    def encode(
+        self, data_bytes: Buffer, zero_copy: Literal[False] = ...
+    ) -> list[bytes]: ...
+
+    @overload
+    def encode(
+        self, data_bytes: Buffer, zero_copy: Literal[True]
+    ) -> list[memoryview]: ...
+
+    def encode(
+        self, data_bytes: Buffer, zero_copy: bool = False
+    ) -> list[bytes] | list[memoryview]:
         """
         Encode an arbitrary-sized string
-        :param data_bytes: the buffer to encode
+        :param data_bytes: the buffer to encode; any object supporting the
+                           buffer protocol (bytes, bytearray, memoryview,
+                           mmap, ...) is accepted without copying
+        :param zero_copy (optional): return read-only memoryviews of the
+                           buffers allocated by liberasurecode rather than
+                           copying each fragment into a new bytes object;
+                           the native memory is freed once every view
+                           has been released
         :returns: a list of buffers (first k entries are data and
                   the last m are parity)
         :raises: ECDriverError if there is an error during encoding
         """
+        if zero_copy:
+            return self.ec_lib_reference.encode(data_bytes, zero_copy=True)
         return self.ec_lib_reference.encode(data_bytes)
 
+    def encode_into(
+        self,
+        data_bytes: Buffer,
+        fragment_buffers: list[Buffer],
+    ) -> int:
+        """
+        Encode an arbitrary-sized string into caller-supplied buffers.
+
+        Use get_segment_info() to size the buffers up front; they may be
+        reused across calls to avoid allocating new fragments per request.
+
+        :param data_bytes: the buffer to encode
+        :param fragment_buffers: a list of k + m writable buffers (first k
+                                 receive data and the last m parity), each
+                                 at least fragment_size bytes long
+        :returns: the number of bytes written to each buffer
+        :raises: ECDriverError if there is an error during encoding or a
+                 buffer is too small
+        """
+        return self.ec_lib_reference.encode_into(data_bytes, fragment_buffers)
+
+    def encode_many(
+        self,
+        data_list: Collection[Buffer],
+    ) -> list[list[bytes] | ECDriverError]:
+        """
+        Encode a batch of arbitrary-sized strings in a single call.
+
+        This is equivalent to calling encode() on each item, but crosses
+        into the C library only once, which matters for small segments.
+        Items are still encoded one after another, and every result is kept
+        until the call returns, so for segments of 64 KiB or more this is no
+        faster than a loop over encode(); use encode_segments() to encode
+        large payloads in parallel.
+
+        :param data_list: a list of buffers to encode
+        :returns: a list with one entry per item in data_list: either the
+                  list of fragments encode() would have returned, or the
+                  ECDriverError (subclass) describing why that item failed
+        :raises: ECDriverError if the batch as a whole is invalid
+        """
+        return self.ec_lib_reference.encode_many(data_list)
+
+    def encode_segments(
+        self,
+        data_bytes: Buffer,
+        segment_size: int,
+        threads: int = 1,
+    ) -> list[list[bytes]]:
+        """
+        Split a payload into segments and encode them, possibly in parallel.
+
+        Segments are laid out as get_segment_info() describes for
+        len(data_bytes) and segment_size, so this returns the same
+        fragments as encoding each segment separately.  With threads > 1
+        large payloads are encoded faster, to the extent that several CPUs
+        are available.
+
+        :param data_bytes: the buffer to encode
+        :param segment_size: the nominal segment size in bytes
+        :param threads: the maximum number of native threads to encode
+                        segments on; no more threads are used than there
+                        are online CPUs
+        :returns: a list with, per segment, the list of fragments encode()
+                  would have returned for it
+        :raises: ECDriverError if there is an error during encoding
+        """
+        return self.ec_lib_reference.encode_segments(
+            data_bytes, segment_size, threads
+        )
+
+    @overload
     def decode(
         self,
-        fragment_payloads: Sequence[bytes],
+        fragment_payloads: Sequence[Buffer],
         ranges: list[tuple[int, int]] | None = None,
         force_metadata_checks: bool = False,
-    ) -> bytes:
+        zero_copy: Literal[False] = ...,
+    ) -> bytes: ...
+
+    @overload
+    def decode(
+        self,
+        fragment_payloads: Sequence[Buffer],
+        ranges: list[tuple[int, int]] | None = None,
+        force_metadata_checks: bool = False,
+        *,
+        zero_copy: Literal[True],
+    ) -> memoryview: ...
+
+    def decode(
+        self,
+        fragment_payloads: Sequence[Buffer],
+        ranges: list[tuple[int, int]] | None = None,
+        force_metadata_checks: bool = False,
+        zero_copy: bool = False,
+    ) -> bytes | memoryview:
         """
         Decode a set of fragments into a buffer that represents the original
         buffer passed into encode().
 
         :param fragment_payloads: a list of buffers representing a subset of
-                                  the list generated by encode()
+                                  the list generated by encode(); any
+                                  buffer-protocol objects are accepted
         :param ranges (optional): a list of byte ranges to return instead of
                                   the entire buffer
         :param force_metadata_checks (optional): validate collective integrity
                                   of the fragments before trying to decode
+        :param zero_copy (optional): return read-only memoryview(s) of the
+                                  buffer allocated by liberasurecode rather
+                                  than copying it into bytes
         :returns: a buffer
         :raises: ECDriverError if there is an error during decoding
         """
+        if zero_copy:
+            return self.ec_lib_reference.decode(
+                fragment_payloads,
+                ranges,
+                force_metadata_checks,
+                zero_copy=True,
+            )
         return self.ec_lib_reference.decode(
             fragment_payloads, ranges, force_metadata_checks
         )
 
+    def decode_into(
+        self,
+        fragment_payloads: Sequence[Buffer],
+        output_buffer: Buffer,
+        force_metadata_checks: bool = False,
+    ) -> int:
+        """
+        Decode a set of fragments into a caller-supplied buffer.
+
+        :param fragment_payloads: a list of buffers representing a subset of
+                                  the list generated by encode()
+        :param output_buffer: a writable buffer large enough to hold the
+                              original data
+        :param force_metadata_checks (optional): validate collective integrity
+                                  of the fragments before trying to decode
+        :returns: the number of bytes written to output_buffer
+        :raises: ECDriverError if there is an error during decoding or
+                 output_buffer is too small
+        """
+        return self.ec_lib_reference.decode_into(
+            fragment_payloads, output_buffer, force_metadata_checks
+        )
+
+    def decode_many(
+        self,
+        fragment_sets: Collection[Collection[Buffer]],
+        force_metadata_checks: bool = False,
+    ) -> list[bytes | ECDriverError]:
+        """
+        Decode a batch of fragment sets in a single call.
+
+        This is equivalent to calling decode() on each set, but crosses
+        into the C library only once, which matters for small segments.
+        As with encode_many(), there is nothing to gain for segments of
+        64 KiB or more.
+
+        :param fragment_sets: a list of fragment lists, each a subset of the
+                              list generated by encode() for one segment
+        :param force_metadata_checks (optional): validate collective integrity
+                                  of the fragments before trying to decode
+        :returns: a list with one entry per set: either the decoded buffer
+                  or the ECDriverError (subclass) describing why that set
+                  could not be decoded
+        :raises: ECDriverError if the batch as a whole is invalid
+        """
+        return self.ec_lib_reference.decode_many(
+            fragment_sets, force_metadata_checks
+        )
+
+    @overload
     def reconstruct(
         self,
-        available_fragment_payloads: Collection[bytes],
+        available_fragment_payloads: Collection[Buffer],
         missing_fragment_indexes: list[int],
-    ) -> list[bytes]:
+        zero_copy: Literal[False] = ...,
+    ) -> list[bytes]: ...
+
+    @overload
+    def reconstruct(
+        self,
+        available_fragment_payloads: Collection[Buffer],
+        missing_fragment_indexes: list[int],
+        zero_copy: Literal[True],
+    ) -> list[memoryview]: ...
+
+    def reconstruct(
+        self,
+        available_fragment_payloads: Collection[Buffer],
+        missing_fragment_indexes: list[int],
+        zero_copy: bool = False,
+    ) -> list[bytes] | list[memoryview]:
         """
         Reconstruct a missing fragment from a subset of available fragments.
 
@@ -276,16 +548,130 @@ class ECDriver(object):
         :param missing_fragment_indexes: a list of integers representing
                                          the indexes of the fragments to be
                                          reconstructed.
+        :param zero_copy (optional): return read-only memoryviews rather
+                                     than copying each fragment into bytes
         :returns: a list of buffers (ordered by fragment index) containing
                   the reconstructed payload associated with the indexes
                   provided in missing_fragment_indexes
         :raises: ECDriverError if there is an error during decoding or there
                  are not sufficient fragments to decode
         """
+        if zero_copy:
+            return self.ec_lib_reference.reconstruct(
+                available_fragment_payloads,
+                missing_fragment_indexes,
+                zero_copy=True,
+            )
         return self.ec_lib_reference.reconstruct(
             available_fragment_payloads, missing_fragment_indexes
         )
 
+    def _run_async(
+        self,
+        executor: Executor | None,
+        func: Callable[..., Any],
+        *args: Any,
+    ) -> asyncio.Future[Any]:
+        loop = asyncio.get_running_loop()
+        return loop.run_in_executor(
+            executor or _get_async_executor(), functools.partial(func, *args)
+        )
+
+    async def encode_async(
+        self,
+        data_bytes: Buffer,
+        executor: Executor | None = None,
+    ) -> list[bytes]:
+        """
+        Like encode(), but runs in a worker thread so that the event loop
+        is not blocked while the data is encoded.
+
+        :param data_bytes: the buffer to encode; it must not be modified
+                           until the result is available
+        :param executor (optional): the executor to run in; by default a
+                                    pool with one thread per CPU, shared by
+                                    all drivers
+        :returns: a list of buffers, as returned by encode()
+        :raises: ECDriverError if there is an error during encoding
+        """
+        return await self._run_async(executor, self.encode, data_bytes)
+
+    async def decode_async(
+        self,
+        fragment_payloads: Sequence[Buffer],
+        ranges: list[tuple[int, int]] | None = None,
+        force_metadata_checks: bool = False,
+        executor: Executor | None = None,
+    ) -> bytes:
+        """
+        Like decode(), but runs in a worker thread so that the event loop
+        is not blocked while the data is decoded.
+
+        :param executor (optional): the executor to run in; by default a
+                                    pool with one thread per CPU, shared by
+                                    all drivers
+        :returns: a buffer, as returned by decode()
+        :raises: ECDriverError if there is an error during decoding
+        """
+        return await self._run_async(
+            executor,
+            self.decode,
+            fragment_payloads,
+            ranges,
+            force_metadata_checks,
+        )
+
+    async def reconstruct_async(
+        self,
+        available_fragment_payloads: Collection[Buffer],
+        missing_fragment_indexes: list[int],
+        executor: Executor | None = None,
+    ) -> list[bytes]:
+        """
+        Like reconstruct(), but runs in a worker thread so that the event
+        loop is not blocked while the fragments are rebuilt.
+
+        :param executor (optional): the executor to run in; by default a
+                                    pool with one thread per CPU, shared by
+                                    all drivers
+        :returns: a list of buffers, as returned by reconstruct()
+        :raises: ECDriverError if there is an error during reconstruction
+        """
+        return await self._run_async(
+            executor,
+            self.reconstruct,
+            available_fragment_payloads,
+            missing_fragment_indexes,
+        )
+
+    def reconstruct_into(
+        self,
+        available_fragment_payloads: Collection[Buffer],
+        missing_fragment_indexes: list[int],
+        output_buffers: list[Buffer],
+    ) -> int:
+        """
+        Reconstruct missing fragments into caller-supplied buffers.
+
+        :param available_fragment_payloads: a list of buffers representing
+                                            a subset of the list generated
+                                            by encode()
+        :param missing_fragment_indexes: a list of integers representing
+                                         the indexes of the fragments to be
+                                         reconstructed.
+        :param output_buffers: a list of writable buffers, one per entry in
+                               missing_fragment_indexes, each at least as
+                               large as the available fragments
+        :returns: the number of bytes written to each buffer
+        :raises: ECDriverError if there is an error during decoding or there
+                 are not sufficient fragments to decode
+        """
+        return self.ec_lib_reference.reconstruct_into(
+            available_fragment_payloads,
+            missing_fragment_indexes,
+            output_buffers,
+        )
+
     def fragments_needed(
         self,
         reconstruction_indexes: list[int],
@@ -316,9 +702,35 @@ class ECDriver(object):
     def min_parity_fragments_needed(self) -> list[int]:
         return self.ec_lib_reference.min_parity_fragments_needed()
 
+    def stats(self, reset: bool = False) -> pyeclib_c.StatsDict:
+        """
+        Report what the driver has spent its time on, per operation class.
+
+        The "operations" dict is keyed by ``encode``, ``decode``,
+        ``reconstruct``, ``fragments_needed``, ``metadata``, ``verify`` and
+        ``other``.  Each holds the number of ``calls`` and of failed calls
+        (``errors``), the payload and fragment bytes read (``bytes_in``) and
+        produced (``bytes_out``), how much of the output was copied into new
+        bytes objects (``bytes_copied``; output the ``*_into`` methods write
+        into the caller's buffers never is), and the time spent with the GIL
+        released, mostly inside liberasurecode (``native_ns``), versus the
+        rest of the call (``marshal_ns``).  The "errors" dict counts failed
+        calls by exception class name.  Items of encode_many() and
+        decode_many() that fail count as failed calls too, even though the
+        batch itself succeeds.
+
+        The counters are kept by the underlying handle with relaxed atomics,
+        so they are cheap to maintain but a snapshot taken while other
+        threads are busy need not be consistent across fields.
+
+        :param reset: zero the counters after reading them
+        :returns: a dict with "operations" and "errors" keys
+        """
+        return self.ec_lib_reference.stats(reset)
+
     def get_metadata(
         self,
-        fragment: bytes,
+        fragment: Buffer,
         formatted: int = 0,
     ) -> bytes | pyeclib_c.MetadataDict:
         """
@@ -333,9 +745,34 @@ class ECDriver(object):
         """
         return self.ec_lib_reference.get_metadata(fragment, formatted)
 
+    def get_metadata_many(
+        self,
+        fragments: Collection[Buffer],
+    ) -> pyeclib_c.MetadataColumnsDict:
+        """
+        Get the metadata of a batch of fragments in one call.
+
+        Rather than one dict per fragment, the result holds one array.array
+        per field, with entry i describing fragments[i]:
+
+        status: 0, or the (negative) error code if the fragment header could
+                not be parsed; the other fields are then 0
+        index, size, orig_data_size, chksum_mismatch, backend_version: as
+                returned by get_metadata(fragment, formatted=1)
+        chksum_type, backend_id: the numeric values behind the names that
+                get_metadata() returns
+        chksum: the first 32 bits of the checksum, which is all of a CRC32
+
+        :param fragments: a list of buffers, each a fragment generated by
+                          encode()
+        :returns: a dict of array.array columns
+        :raises: ECDriverError if the batch as a whole is invalid
+        """
+        return self.ec_lib_reference.get_metadata_many(fragments)
+
     def verify_stripe_metadata(
         self,
-        fragment_metadata_list: Sequence[bytes],
+        fragment_metadata_list: Sequence[Buffer],
     ) -> pyeclib_c.CheckMetadataResultDict:
         """
         Verify a subset of fragments generated by encode()
@@ -353,6 +790,61 @@ class ECDriver(object):
             fragment_metadata_list
         )
 
+    def verify_stripe(
+        self,
+        fragments: Collection[Buffer],
+        threads: int = 1,
+    ) -> pyeclib_c.VerifyStripeResultDict:
+        """
+        Fully verify a set of fragments from one stripe.
+
+        Unlike verify_stripe_metadata(), which only compares headers, this
+        checks each fragment's header checksum, its inline CRC32 over the
+        payload (when encoded with chksum_type="inline_crc32"), its length
+        against its header, and that orig_data_size, size, backend id and
+        backend version agree with the majority of the stripe.  The work
+        is done natively without holding the GIL.
+
+        Returns a dict with the following keys:
+
+        status: 0 if every fragment is healthy, otherwise a negative error
+                code
+        bad_fragments: positions in fragments of the unhealthy fragments
+        reasons: for each of bad_fragments, a description of the problem
+
+        :param fragments: a list of buffers, typically all k + m fragments
+                          generated by one call to encode()
+        :param threads: the maximum number of native threads to verify
+                        fragments on; no more threads are used than there
+                        are online CPUs
+        :returns: a dict as described above
+        :raises: ECDriverError if the fragments could not be checked at all
+        """
+        return self.ec_lib_reference.verify_stripe(fragments, threads)
+
+    def scrub_stripe(self, fragments: Collection[Buffer]) -> list[int]:
+        """
+        Check that a stripe's fragments actually encode the same payload.
+
+        Checksums cannot tell when a fragment is internally consistent but
+        holds the wrong bytes, e.g. stale or mis-encoded parity.  This
+        re-encodes the payload recovered from the stripe's data fragments
+        (or decoded from whatever fragments are given, when some data
+        fragments are missing) and compares every fragment's payload with
+        the re-encoded one, natively and without holding the GIL.
+
+        Run verify_stripe() first: the data fragments are taken as the
+        reference, so a corrupt data fragment makes the parity look wrong.
+
+        :param fragments: a list of buffers, typically all k + m fragments
+                          generated by one call to encode()
+        :returns: the indexes of fragments that differ from the re-encoded
+                  stripe; empty if the stripe is consistent
+        :raises: ECDriverError if the stripe could not be decoded or
+                 re-encoded
+        """
+        return self.ec_lib_reference.scrub_stripe(fragments)
+
     def get_segment_info(
         self,
         data_len: int,
@@ -383,6 +875,26 @@ class ECDriver(object):
         """
         return self.ec_lib_reference.get_segment_info(data_len, segment_size)
 
+    def stream_encoder(self, segment_size: int) -> pyeclib_c.ECStreamEncoder:
+        """
+        Create an incremental encoder for a stream of unknown length.
+
+        Data is passed to the encoder's feed() method in chunks of any size;
+        each call returns a (possibly empty) list with the fragments of
+        every segment completed so far.  Once the stream ends, finish()
+        returns the fragments of the final segment.
+
+        Segments are laid out exactly as get_segment_info() describes for
+        the total length: every segment is segment_size bytes except the
+        last, which absorbs any tail shorter than the minimum encode size.
+        At most one segment is buffered at a time.
+
+        :param segment_size: the nominal segment size in bytes
+        :returns: an ECStreamEncoder
+        :raises: ECDriverError if segment_size is invalid
+        """
+        return self.ec_lib_reference.stream_encoder(segment_size)
+
     #
     # Map of segment indexes with a list of tuples
     #
@@ -463,6 +975,136 @@ class ECDriver(object):
 
         return recipe
 
+    def stream_decoder(
+        self,
+        ranges: list[tuple[int, int]],
+        data_len: int,
+        segment_size: int,
+    ) -> ECStreamDecoder:
+        """
+        Create a decoder that returns only the requested byte ranges of a
+        segmented object, one segment at a time.
+
+        See ECStreamDecoder for details.
+
+        :param ranges: a list of (begin, end) byte ranges, end inclusive
+        :param data_len: the total length of the object
+        :param segment_size: the segment size the object was encoded with
+        :returns: an ECStreamDecoder
+        :raises: ECInvalidParameter if a range is outside of the object
+        """
+        return ECStreamDecoder(self, ranges, data_len, segment_size)
+
+
+class ECStreamDecoder(object):
+    """
+    Decode byte ranges of a segmented object without holding whole segments.
+
+    The decoder works out which segments the ranges touch (honoring the
+    merged last segment described by get_segment_info()) and lists them in
+    ``segments``.  The caller then passes decode() an iterable yielding one
+    fragment set per entry of ``segments``, in that order, e.g. a generator
+    reading the fragments of each needed segment from the network.
+
+    Each fragment set is decoded with only the sub-ranges that fall inside
+    that segment, so only the requested bytes are ever copied out of the C
+    library, and the set is released before the next one is pulled from
+    the iterable.  Memory use is therefore bounded by a single segment no
+    matter how large the object or the ranges are.
+    """
+
+    def __init__(
+        self,
+        driver: ECDriver,
+        ranges: list[tuple[int, int]],
+        data_len: int,
+        segment_size: int,
+    ):
+        self.driver = driver
+        self.ranges = list(ranges)
+        self.data_len = data_len
+        self.segment_size = segment_size
+        self.segments: list[int] = []
+
+        # segment index -> [(range index, begin, end)], relative offsets
+        self._plan: dict[int, list[tuple[int, int, int]]] = {}
+        if not self.ranges:
+            return
+        if data_len <= 0:
+            raise ECInvalidParameter("Invalid range for empty object")
+
+        info = driver.get_segment_info(data_len, segment_size)
+        self.segment_size = info["segment_size"]
+        num_segments = info["num_segments"]
+        last_segment = num_segments - 1
+
+        for idx, (begin, end) in enumerate(self.ranges):
+            if not 0 <= begin <= end < data_len:
+                raise ECInvalidParameter(
+                    f"Invalid range ({begin}, {end}) for object of "
+                    f"length {data_len}"
+                )
+            # Offsets in a merged tail belong to the last segment
+            first = min(begin // self.segment_size, last_segment)
+            last = min(end // self.segment_size, last_segment)
+            for segment in range(first, last + 1):
+                segment_start = segment * self.segment_size
+                if segment == last_segment:
+                    segment_end = data_len - 1
+                else:
+                    segment_end = segment_start + self.segment_size - 1
+                self._plan.setdefault(segment, []).append(
+                    (
+                        idx,
+                        max(begin, segment_start) - segment_start,
+                        min(end, segment_end) - segment_start,
+                    )
+                )
+        self.segments = sorted(self._plan)
+
+    def decode(
+        self,
+        fragment_sets: Iterable[Sequence[Buffer]],
+        force_metadata_checks: bool = False,
+    ) -> Iterator[tuple[tuple[int, int], bytes]]:
+        """
+        Yield the requested bytes, segment by segment.
+
+        :param fragment_sets: an iterable yielding the fragments of each
+                              segment listed in ``segments``, in order
+        :param force_metadata_checks (optional): validate collective integrity
+                                  of the fragments before trying to decode
+        :returns: an iterator of (range, data) pairs, where range is one of
+                  the requested ranges and data is the part of it stored in
+                  the current segment.  Pieces are produced in segment
+                  order; for sorted, non-overlapping ranges that is also
+                  the order of the ranges, so the data can be streamed
+                  straight to the client.
+        :raises: ECDriverError if there is an error during decoding or the
+                 iterable runs out of fragment sets
+        """
+        sets = iter(fragment_sets)
+        for segment in self.segments:
+            fragments = next(sets, None)
+            if fragments is None:
+                raise ECInsufficientFragments(
+                    f"No fragments given for segment {segment}"
+                )
+            plan = self._plan[segment]
+            # Ranged decode returns a list with one entry per range
+            pieces = cast(
+                "list[bytes]",
+                self.driver.decode(
+                    fragments,
+                    [(begin, end) for _, begin, end in plan],
+                    force_metadata_checks,
+                ),
+            )
+            # Drop our reference before yielding so the fragments can go
+            del fragments
+            for (idx, _, _), piece in zip(plan, pieces):
+                yield self.ranges[idx], piece
+
 
 # PyECLib helper for "available" EC types
 ALL_EC_TYPES = [
@@ -1,10 +1,16 @@
+from array import array
 from typing import (
+    Literal,
     NewType,
     Sequence,
     TypedDict,
+    overload,
 )
+from typing_extensions import Buffer
 from typing_extensions import NotRequired
 
+from pyeclib.exceptions import ECDriverError
+
 def get_liberasurecode_version() -> int: ...
 def check_backend_available(
     backend_id: int,
@@ -23,20 +29,93 @@ def init(
     local_parity: int,
 ) -> PyECLibHandle: ...
 def destroy(instance: PyECLibHandle) -> None: ...
-def encode(instance: PyECLibHandle, data: bytes) -> list[bytes]: ...
+@overload
+def encode(
+    instance: PyECLibHandle,
+    data: Buffer,
+    zero_copy: Literal[False] = False,
+) -> list[bytes]: ...
+@overload
+def encode(
+    instance: PyECLibHandle,
+    data: Buffer,
+    zero_copy: bool,
+) -> list[bytes] | list[memoryview]: ...
+def encode_many(
+    instance: PyECLibHandle,
+    data: list[Buffer],
+) -> list[list[bytes] | ECDriverError]: ...
+def encode_segments(
+    instance: PyECLibHandle,
+    data: Buffer,
+    segment_size: int,
+    num_threads: int,
+) -> list[list[bytes]]: ...
+def encode_into(
+    instance: PyECLibHandle,
+    data: Buffer,
+    outputs: list[Buffer],
+) -> int: ...
+@overload
 def decode(
     instance: PyECLibHandle,
-    fragments: Sequence[bytes],
+    fragments: Sequence[Buffer],
     fragment_length: int,
     ranges: list[tuple[int, int]] | None = None,
     force_metadata_checks: bool = False,
+    zero_copy: Literal[False] = False,
 ) -> bytes: ...
+@overload
+def decode(
+    instance: PyECLibHandle,
+    fragments: Sequence[Buffer],
+    fragment_length: int,
+    ranges: list[tuple[int, int]] | None,
+    force_metadata_checks: bool,
+    zero_copy: bool,
+) -> bytes | memoryview: ...
+def decode_many(
+    instance: PyECLibHandle,
+    fragment_sets: list[list[Buffer]],
+    force_metadata_checks: bool = False,
+) -> list[bytes | ECDriverError]: ...
+def decode_into(
+    instance: PyECLibHandle,
+    fragments: Sequence[Buffer],
+    fragment_length: int,
+    output: Buffer,
+    force_metadata_checks: bool = False,
+) -> int: ...
+@overload
 def reconstruct(
     instance: PyECLibHandle,
-    fragments: Sequence[bytes],
+    fragments: Sequence[Buffer],
     fragment_length: int,
     index_to_rebuild: int,
+    zero_copy: Literal[False] = False,
 ) -> bytes: ...
+@overload
+def reconstruct(
+    instance: PyECLibHandle,
+    fragments: Sequence[Buffer],
+    fragment_length: int,
+    index_to_rebuild: int,
+    zero_copy: bool,
+) -> bytes | memoryview: ...
+def reconstruct_many(
+    instance: PyECLibHandle,
+    fragments: Sequence[Buffer],
+    fragment_length: int,
+    indexes_to_rebuild: list[int],
+    zero_copy: bool = False,
+) -> list[bytes] | list[memoryview]: ...
+def reconstruct_into(
+    instance: PyECLibHandle,
+    fragments: Sequence[Buffer],
+    fragment_length: int,
+    index_to_rebuild: int,
+    output: Buffer,
+) -> int: ...
 
 class CheckMetadataResultDict(TypedDict):
     status: int
@@ -45,9 +124,25 @@ class CheckMetadataResultDict(TypedDict):
 
 def check_metadata(
     instance: PyECLibHandle,
-    fragments: Sequence[bytes],
+    fragments: Sequence[Buffer],
 ) -> CheckMetadataResultDict: ...
 
+class VerifyStripeResultDict(TypedDict):
+    status: int
+    bad_fragments: list[int]
+    reasons: list[str]
+
+def verify_stripe(
+    instance: PyECLibHandle,
+    fragments: list[Buffer],
+    num_threads: int = ...,
+) -> VerifyStripeResultDict: ...
+
+def scrub_stripe(
+    instance: PyECLibHandle,
+    fragments: list[Buffer],
+) -> list[int]: ...
+
 class MetadataDict(TypedDict):
     index: int
     size: int
@@ -60,15 +155,77 @@ class MetadataDict(TypedDict):
 
 def get_metadata(
     instance: PyECLibHandle,
-    fragment: bytes,
+    fragment: Buffer,
     formatted: int,
 ) -> bytes | MetadataDict: ...
+
+class MetadataColumnsDict(TypedDict):
+    status: array[int]
+    index: array[int]
+    size: array[int]
+    orig_data_size: array[int]
+    chksum_type: array[int]
+    chksum: array[int]
+    chksum_mismatch: array[int]
+    backend_id: array[int]
+    backend_version: array[int]
+
+def get_metadata_many(
+    instance: PyECLibHandle,
+    fragments: list[Buffer],
+) -> MetadataColumnsDict: ...
+
+class ScanResultDict(TypedDict):
+    offset: array[int]
+    length: array[int]
+    index: array[int]
+    size: array[int]
+    orig_data_size: array[int]
+    chksum_type: array[int]
+    chksum: array[int]
+    chksum_mismatch: array[int]
+    backend_id: array[int]
+    backend_version: array[int]
+    scanned: int
+    error: int
+
+def scan_fragments(
+    buffer: Buffer,
+    verify_checksums: bool = ...,
+) -> ScanResultDict: ...
+
 def get_required_fragments(
     instance: PyECLibHandle,
     reconstruct_list: list[int],
     exclude_list: list[int],
 ) -> list[int]: ...
 
+def bench_native(
+    instance: PyECLibHandle,
+    op: Literal["encode", "decode", "reconstruct"],
+    payload: Buffer | list[Buffer],
+    iterations: int,
+    index: int = ...,
+) -> int: ...
+
+class OpStatsDict(TypedDict):
+    calls: int
+    errors: int
+    bytes_in: int
+    bytes_out: int
+    bytes_copied: int
+    native_ns: int
+    marshal_ns: int
+
+class StatsDict(TypedDict):
+    operations: dict[str, OpStatsDict]
+    errors: dict[str, int]
+
+def get_stats(
+    instance: PyECLibHandle,
+    reset: bool = ...,
+) -> StatsDict: ...
+
 class SegmentInfoDict(TypedDict):
     segment_size: int
     last_segment_size: int
@@ -81,3 +238,14 @@ def get_segment_info(
     data_length: int,
     segment_size: int,
 ) -> SegmentInfoDict: ...
+
+class ECStreamEncoder:
+    def __init__(self, handle: PyECLibHandle, segment_size: int) -> None: ...
+    @property
+    def segment_size(self) -> int: ...
+    @property
+    def num_segments(self) -> int: ...
+    @property
+    def buffered(self) -> int: ...
+    def feed(self, data: Buffer) -> list[list[bytes]]: ...
+    def finish(self) -> list[list[bytes]]: ...
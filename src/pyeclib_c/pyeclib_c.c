@@ -27,6 +27,9 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <paths.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
 #define PY_SSIZE_T_CLEAN
 #include <Python.h>
 #include <math.h>
@@ -35,6 +38,37 @@
 
 #include <pyeclib_c.h>
 
+/*
+ * USDT probes, for tracing with bpftrace, perf or SystemTap; see
+ * doc/source/tracing.rst.  Each probe is a single nop until a tracer attaches
+ * and its arguments are locals that are already at hand.  Without
+ * <sys/sdt.h>, or with PYECLIB_NO_PROBES defined, they compile to nothing.
+ */
+#if defined(__has_include) && !defined(PYECLIB_NO_PROBES)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define PYECLIB_HAVE_PROBES 1
+#endif
+#endif
+
+#ifdef PYECLIB_HAVE_PROBES
+#define PYECLIB_PROBE(name, ...) STAP_PROBEV(pyeclib, name, __VA_ARGS__)
+#else
+/* Arguments only computed for the probes must not look unused */
+#define PYECLIB_PROBE(name, ...) \
+      do { (void) sizeof((int64_t[]) { __VA_ARGS__ }); } while (0)
+#endif
+
+/*
+ * Return code reported by the *_return probes: 0 on success, the
+ * liberasurecode error code if that is what failed, -1 otherwise.
+ */
+#define PYECLIB_PROBE_RC(result, ret) \
+      ((NULL != (result)) ? 0 : ((ret) < 0 ? (ret) : -1))
+
+#define PYECLIB_PROBE_HANDLE(h) \
+      (h)->ec_args.k, (h)->ec_args.m, (int) (h)->backend_id
+
 #define MOD_ERROR_VAL NULL
 #define MOD_SUCCESS_VAL(val) val
 #define MOD_INIT(name) PyMODINIT_FUNC PyInit_##name(void)
@@ -46,8 +80,14 @@
       Py_BuildValue("y#", obj, (Py_ssize_t)objlen)
 #define PyInt_FromLong PyLong_FromLong
 #define PyString_FromString PyUnicode_FromString
-#define ENCODE_ARGS "Oy#"
-#define GET_METADATA_ARGS "Oy#i"
+#define ENCODE_ARGS "Oy*|p"
+/*
+ * encode_many() and decode_many() turn results into Python objects after
+ * at most this many input bytes, so liberasurecode's buffers are copied out
+ * while still in cache and only one chunk of them is alive at a time.
+ */
+#define BATCH_CHUNK_BYTES (256 * 1024)
+#define GET_METADATA_ARGS "Oy*i"
 
 
 typedef struct pyeclib_byte_range {
@@ -62,11 +102,20 @@ static PyObject * pyeclib_c_init(PyObject *self, PyObject *args);
 static void pyeclib_c_destructor(PyObject *obj);
 static PyObject * pyeclib_c_get_segment_info(PyObject *self, PyObject *args);
 static PyObject * pyeclib_c_encode(PyObject *self, PyObject *args);
+static PyObject * pyeclib_c_encode_into(PyObject *self, PyObject *args);
+static PyObject * pyeclib_c_encode_many(PyObject *self, PyObject *args);
+static PyObject * pyeclib_c_encode_segments(PyObject *self, PyObject *args);
 static PyObject * pyeclib_c_reconstruct(PyObject *self, PyObject *args);
+static PyObject * pyeclib_c_reconstruct_into(PyObject *self, PyObject *args);
+static PyObject * pyeclib_c_reconstruct_many(PyObject *self, PyObject *args);
 static PyObject * pyeclib_c_decode(PyObject *self, PyObject *args);
+static PyObject * pyeclib_c_decode_into(PyObject *self, PyObject *args);
+static PyObject * pyeclib_c_decode_many(PyObject *self, PyObject *args);
 static PyObject * pyeclib_c_get_metadata(PyObject *self, PyObject *args);
 static PyObject * pyeclib_c_check_metadata(PyObject *self, PyObject *args);
+static PyObject * pyeclib_c_get_stats(PyObject *self, PyObject *args);
 static PyObject * pyeclib_c_liberasurecode_version(PyObject *self, PyObject *args);
+static void release_fragment_buffers(Py_buffer *views, int num_fragments);
 
 static PyObject *import_class(const char *module, const char *cls)
 {
@@ -122,14 +171,20 @@ void * check_and_free_buffer(void * buf)
     return NULL;
 }
 
-void pyeclib_c_seterr(int ret, const char * prefix) {
+/**
+ * Build (but do not raise) the pyeclib exception for a liberasurecode error.
+ *
+ * @param ret negative liberasurecode error code
+ * @param prefix name of the failing call, used in the message
+ * @return new reference to an exception instance, or NULL with an error set
+ */
+static PyObject *
+pyeclib_c_error(int ret, const char * prefix) {
     char *err_class;
     char *err_msg;
     char err[255];
-
-    // If any error was previously set, we're explicitly ignoring it
-    // to raise something new
-    PyErr_Clear();
+    PyObject *eo;
+    PyObject *exc;
 
     switch (ret) {
         case -EBACKENDNOTAVAIL:
@@ -173,12 +228,224 @@ void pyeclib_c_seterr(int ret, const char * prefix) {
             err_msg = "Unknown error";
             break;
     }
-    PyObject *eo = import_class("pyeclib.exceptions", err_class);
-    if (eo != NULL) {
-        snprintf(err, 255,
-                "%s ERROR: %s. Please inspect syslog for liberasurecode error report.",
-                prefix, err_msg);
-        PyErr_SetString(eo, err);
+    eo = import_class("pyeclib.exceptions", err_class);
+    if (eo == NULL) {
+        return NULL;
+    }
+    snprintf(err, 255,
+            "%s ERROR: %s. Please inspect syslog for liberasurecode error report.",
+            prefix, err_msg);
+    exc = PyObject_CallFunction(eo, "s", err);
+    Py_DECREF(eo);
+    return exc;
+}
+
+static uint64_t
+monotonic_ns(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/**
+ * Per-call statistics, folded into the handle by stats_call_end().
+ *
+ * The call running on a thread is found through current_call, so that
+ * pyeclib_c_seterr() and the byte counting helpers need no extra arguments.
+ * Outside of a counted call they do nothing.
+ */
+typedef struct pyeclib_call_s {
+  pyeclib_t *handle;
+  pyeclib_op_t op;
+  struct pyeclib_call_s *prev;      /* call this one is nested in */
+  int error;                        /* last code passed to pyeclib_c_seterr */
+  uint64_t start_ns;
+  uint64_t native_ns;
+  uint64_t bytes_in;
+  uint64_t bytes_out;
+  uint64_t bytes_copied;
+  uint64_t item_errors[PYECLIB_NUM_ERRS];   /* failed items of a batch */
+} pyeclib_call_t;
+
+static __thread pyeclib_call_t *current_call = NULL;
+
+#define STATS_ADD(counter, n) \
+      __atomic_fetch_add(&(counter), (uint64_t) (n), __ATOMIC_RELAXED)
+#define STATS_TAKE(counter, reset) \
+      ((reset) ? __atomic_exchange_n(&(counter), 0, __ATOMIC_RELAXED) \
+               : __atomic_load_n(&(counter), __ATOMIC_RELAXED))
+
+/*
+ * Drop the GIL around native work, like Py_BEGIN/END_ALLOW_THREADS, and
+ * charge the time spent to the current call.
+ */
+#define PYECLIB_BEGIN_NATIVE { \
+      pyeclib_call_t *_native_call = current_call; \
+      uint64_t _native_start = _native_call ? monotonic_ns() : 0; \
+      Py_BEGIN_ALLOW_THREADS
+#define PYECLIB_END_NATIVE \
+      Py_END_ALLOW_THREADS \
+      if (NULL != _native_call) { \
+        _native_call->native_ns += monotonic_ns() - _native_start; \
+      } \
+    }
+
+static void
+stats_count_in(uint64_t len)
+{
+  if (NULL != current_call) {
+    current_call->bytes_in += len;
+  }
+}
+
+/**
+ * Count len bytes of output; copied says whether they went into a new
+ * object.  Output written into buffers supplied by the caller, as by the
+ * *_into calls, is never counted as copied.
+ */
+static void
+stats_count_out(uint64_t len, int copied)
+{
+  if (NULL != current_call) {
+    current_call->bytes_out += len;
+    if (copied) {
+      current_call->bytes_copied += len;
+    }
+  }
+}
+
+/**
+ * Count the buffers in a call's result as output.  New bytes objects were
+ * copied out of liberasurecode's memory; memoryviews and bytearrays were not.
+ */
+static void
+stats_count_result(PyObject *obj)
+{
+  Py_ssize_t i;
+
+  if (NULL == current_call) {
+    return;
+  }
+  if (PyBytes_Check(obj)) {
+    stats_count_out(PyBytes_GET_SIZE(obj), 1);
+  } else if (PyMemoryView_Check(obj)) {
+    stats_count_out(PyMemoryView_GET_BUFFER(obj)->len, 0);
+  } else if (PyByteArray_Check(obj)) {
+    stats_count_out(PyByteArray_GET_SIZE(obj), 0);
+  } else if (PyList_Check(obj)) {
+    for (i = 0; i < PyList_GET_SIZE(obj); i++) {
+      stats_count_result(PyList_GET_ITEM(obj, i));
+    }
+  } else if (PyTuple_Check(obj)) {
+    for (i = 0; i < PyTuple_GET_SIZE(obj); i++) {
+      stats_count_result(PyTuple_GET_ITEM(obj, i));
+    }
+  }
+}
+
+static pyeclib_err_t
+stats_error_slot(int ret)
+{
+  switch (ret) {
+    case -EBACKENDNOTAVAIL:
+      return PYECLIB_ERR_BACKENDNOTAVAIL;
+    case -EINSUFFFRAGS:
+      return PYECLIB_ERR_INSUFFFRAGS;
+    case -EBACKENDNOTSUPP:
+      return PYECLIB_ERR_BACKENDNOTSUPP;
+    case -EINVALIDPARAMS:
+      return PYECLIB_ERR_INVALIDPARAMS;
+    case -EBADCHKSUM:
+      return PYECLIB_ERR_BADCHKSUM;
+    case -EBADHEADER:
+      return PYECLIB_ERR_BADHEADER;
+    case -ENOMEM:
+      return PYECLIB_ERR_NOMEM;
+    default:
+      return PYECLIB_ERR_OTHER;
+  }
+}
+
+/**
+ * Count a failed item of encode_many() or decode_many().  The call itself
+ * succeeds and returns the exception in place of that item's result, but
+ * the failure is still reported by get_stats().
+ */
+static void
+stats_count_item_error(int ret)
+{
+  if (NULL != current_call) {
+    current_call->item_errors[stats_error_slot(ret)]++;
+  }
+}
+
+/* Exception class names reported by get_stats(), by pyeclib_err_t */
+static const char *stats_error_names[PYECLIB_NUM_ERRS] = {
+  "ECBackendInstanceNotAvailable",
+  "ECInsufficientFragments",
+  "ECBackendNotSupported",
+  "ECInvalidParameter",
+  "ECBadFragmentChecksum",
+  "ECInvalidFragmentMetadata",
+  "ECOutOfMemory",
+  "ECDriverError",
+};
+
+static void
+stats_call_begin(pyeclib_call_t *call, pyeclib_t *pyeclib_handle,
+                 pyeclib_op_t op)
+{
+  memset(call, 0, sizeof(*call));
+  call->handle = pyeclib_handle;
+  call->op = op;
+  call->prev = current_call;
+  call->start_ns = monotonic_ns();
+  current_call = call;
+}
+
+static void
+stats_call_end(pyeclib_call_t *call, int failed)
+{
+  pyeclib_t *pyeclib_handle = call->handle;
+  pyeclib_op_stats_t *stats = &pyeclib_handle->stats[call->op];
+  int i;
+
+  current_call = call->prev;
+  STATS_ADD(stats->calls, 1);
+  if (failed) {
+    STATS_ADD(stats->errors, 1);
+    STATS_ADD(pyeclib_handle->errors[stats_error_slot(call->error)], 1);
+  }
+  for (i = 0; i < PYECLIB_NUM_ERRS; i++) {
+    if (call->item_errors[i] > 0) {
+      STATS_ADD(stats->errors, call->item_errors[i]);
+      STATS_ADD(pyeclib_handle->errors[i], call->item_errors[i]);
+    }
+  }
+  STATS_ADD(stats->bytes_in, call->bytes_in);
+  STATS_ADD(stats->bytes_out, call->bytes_out);
+  STATS_ADD(stats->bytes_copied, call->bytes_copied);
+  STATS_ADD(stats->total_ns, monotonic_ns() - call->start_ns);
+  STATS_ADD(stats->native_ns, call->native_ns);
+}
+
+void pyeclib_c_seterr(int ret, const char * prefix) {
+    PyObject *exc;
+
+    if (NULL != current_call) {
+      current_call->error = ret;
+    }
+
+    // If any error was previously set, we're explicitly ignoring it
+    // to raise something new
+    PyErr_Clear();
+
+    exc = pyeclib_c_error(ret, prefix);
+    if (exc != NULL) {
+        PyErr_SetObject((PyObject *) Py_TYPE(exc), exc);
+        Py_DECREF(exc);
     }
 }
 
@@ -205,6 +472,359 @@ static void restore_stderr(void)
     fsetpos(stderr, &stderr_fpos);        /* for C9X */
 }
 
+/**
+ * Acquire contiguous buffers for every item of a list of fragments.
+ *
+ * Any object supporting the buffer protocol (bytes, bytearray, memoryview,
+ * mmap, ...) is accepted without copying.  Holding the buffers also keeps
+ * the exporting objects alive, so the pointers in c_fragments remain valid
+ * while the GIL is released, even if another thread mutates the list.
+ *
+ * @param list python list of fragments
+ * @param num_fragments number of items in the list
+ * @param min_len minimum length in bytes of each fragment
+ * @param flags buffer request flags, PyBUF_SIMPLE or PyBUF_WRITABLE
+ * @param views out param, array of buffers for release_fragment_buffers()
+ * @param c_fragments array of num_fragments pointers to fill in
+ * @return 0 on success, or a negative error code
+ */
+static int
+get_fragment_buffers(PyObject *list, int num_fragments, Py_ssize_t min_len,
+                     int flags, Py_buffer **views, char **c_fragments)
+{
+    Py_buffer *bufs = NULL;
+    int i;
+
+    *views = NULL;
+    bufs = (Py_buffer *) alloc_zeroed_buffer(sizeof(Py_buffer) * num_fragments);
+    if (NULL == bufs) {
+        return -ENOMEM;
+    }
+
+    for (i = 0; i < num_fragments; i++) {
+        PyObject *tmp_data = PyList_GetItem(list, i);
+        if (NULL == tmp_data ||
+            PyObject_GetBuffer(tmp_data, &bufs[i], flags) < 0 ||
+            bufs[i].len < min_len) {
+            release_fragment_buffers(bufs, num_fragments);
+            return -EINVALIDPARAMS;
+        }
+        c_fragments[i] = (char *) bufs[i].buf;
+        if (!(flags & PyBUF_WRITABLE)) {
+            stats_count_in(bufs[i].len);
+        }
+    }
+
+    *views = bufs;
+    return 0;
+}
+
+/**
+ * Give back the buffers acquired by get_fragment_buffers().
+ *
+ * @param views array of buffers, may be NULL
+ * @param num_fragments number of buffers in the array
+ */
+static void
+release_fragment_buffers(Py_buffer *views, int num_fragments)
+{
+    int i;
+
+    if (NULL == views) {
+        return;
+    }
+    for (i = 0; i < num_fragments; i++) {
+        PyBuffer_Release(&views[i]);
+    }
+    free(views);
+}
+
+/**
+ * Copy the output of liberasurecode_encode() into a python list of bytes.
+ *
+ * @param k number of data fragments
+ * @param m number of parity fragments
+ * @param encoded_data array of k data fragments
+ * @param encoded_parity array of m parity fragments
+ * @param fragment_len length in bytes of each fragment
+ * @return new list of k + m bytes objects, or NULL with an error set
+ */
+static PyObject *
+encoded_fragments_to_list(int k, int m, char **encoded_data,
+                          char **encoded_parity, uint64_t fragment_len)
+{
+  PyObject *list;
+  int i;
+
+  list = PyList_New(k + m);
+  if (NULL == list) {
+    pyeclib_c_seterr(-ENOMEM, "pyeclib_c_encode");
+    return NULL;
+  }
+  for (i = 0; i < k + m; i++) {
+    char *fragment = (i < k) ? encoded_data[i] : encoded_parity[i - k];
+    PyObject *item = PY_BUILDVALUE_OBJ_LEN(fragment, fragment_len);
+
+    if (NULL == item) {
+      Py_DECREF(list);
+      return NULL;
+    }
+    PyList_SetItem(list, i, item);
+  }
+  return list;
+}
+
+/**
+ * Zero-copy results.
+ *
+ * A pyeclib_native_result_t records memory allocated by liberasurecode (or
+ * by us) for one encode/decode/reconstruct call.  It is owned by a capsule
+ * whose destructor gives the memory back, and every memoryview handed to
+ * the caller is backed by a NativeBuffer that holds a reference to that
+ * capsule.  The memory is therefore freed only once the last view (and
+ * anything sliced from it) has been released.
+ *
+ * Memory from liberasurecode can only be given back through the instance
+ * that allocated it, so such a result also pins the handle: destroy() leaves
+ * the instance to be destroyed along with the last of its results.
+ */
+#define PYECC_NATIVE_RESULT_NAME    "pyeclib_native_result"
+
+typedef struct pyeclib_native_result_s {
+  PyObject *handle;                 /* pinned handle capsule, or NULL */
+  pyeclib_t *pyeclib_handle;
+  char **encoded_data;              /* from liberasurecode_encode */
+  char **encoded_parity;            /* from liberasurecode_encode */
+  char *decoded;                    /* from liberasurecode_decode */
+  char *reconstructed;              /* allocated by pyeclib_c_reconstruct */
+} pyeclib_native_result_t;
+
+typedef struct {
+  PyObject_HEAD
+  PyObject *owner;                  /* capsule holding the native result */
+  char *buf;
+  Py_ssize_t len;
+} pyeclib_native_buffer_t;
+
+static PyTypeObject *NativeBufferType = NULL;
+
+/**
+ * Pin the liberasurecode instance of a handle for a zero-copy result.
+ *
+ * Must be called while the handle is pinned for a call, so that it cannot
+ * have been destroyed yet.
+ */
+static void
+native_result_pin(pyeclib_native_result_t *result, PyObject *handle,
+                  pyeclib_t *pyeclib_handle)
+{
+  pthread_mutex_lock(&pyeclib_handle->lock);
+  pyeclib_handle->results++;
+  pthread_mutex_unlock(&pyeclib_handle->lock);
+  Py_INCREF(handle);
+  result->handle = handle;
+  result->pyeclib_handle = pyeclib_handle;
+}
+
+static void
+native_result_free(pyeclib_native_result_t *result)
+{
+  pyeclib_t *pyeclib_handle = result->pyeclib_handle;
+  int retire = 0;
+
+  if (NULL != pyeclib_handle) {
+    /* The instance is still alive, as this result pins it */
+    if (NULL != result->encoded_data || NULL != result->encoded_parity) {
+      liberasurecode_encode_cleanup(pyeclib_handle->ec_desc,
+                                    result->encoded_data,
+                                    result->encoded_parity);
+    }
+    if (NULL != result->decoded) {
+      liberasurecode_decode_cleanup(pyeclib_handle->ec_desc, result->decoded);
+    }
+
+    pthread_mutex_lock(&pyeclib_handle->lock);
+    retire = --pyeclib_handle->results == 0 && pyeclib_handle->destroyed;
+    pthread_mutex_unlock(&pyeclib_handle->lock);
+    if (retire) {
+      /* destroy() was called while this result was alive */
+      liberasurecode_instance_destroy(pyeclib_handle->ec_desc);
+    }
+    Py_DECREF(result->handle);
+  }
+  check_and_free_buffer(result->reconstructed);
+  free(result);
+}
+
+static void
+pyeclib_native_result_destructor(PyObject *obj)
+{
+  pyeclib_native_result_t *result;
+
+  result = (pyeclib_native_result_t *) PyCapsule_GetPointer(obj, PYECC_NATIVE_RESULT_NAME);
+  if (NULL != result) {
+    native_result_free(result);
+  }
+}
+
+/**
+ * Wrap native memory in a capsule that frees it when no longer referenced.
+ *
+ * On failure the memory is freed immediately and NULL is returned.
+ *
+ * @param result heap allocated description of the native memory
+ * @return new reference to the owning capsule, or NULL on error
+ */
+static PyObject *
+native_result_new(pyeclib_native_result_t *result)
+{
+  PyObject *owner;
+
+  owner = PyCapsule_New(result, PYECC_NATIVE_RESULT_NAME, pyeclib_native_result_destructor);
+  if (NULL == owner) {
+    native_result_free(result);
+  }
+  return owner;
+}
+
+static int
+native_buffer_getbuffer(PyObject *exporter, Py_buffer *view, int flags)
+{
+  pyeclib_native_buffer_t *self = (pyeclib_native_buffer_t *) exporter;
+
+  return PyBuffer_FillInfo(view, exporter, self->buf, self->len, 1, flags);
+}
+
+static void
+native_buffer_dealloc(PyObject *obj)
+{
+  pyeclib_native_buffer_t *self = (pyeclib_native_buffer_t *) obj;
+  PyTypeObject *tp = Py_TYPE(obj);
+
+  Py_XDECREF(self->owner);
+  PyObject_Free(obj);
+  Py_DECREF(tp);
+}
+
+static PyType_Slot native_buffer_slots[] = {
+  {Py_tp_dealloc, native_buffer_dealloc},
+  {Py_bf_getbuffer, native_buffer_getbuffer},
+  {0, NULL},
+};
+
+static PyType_Spec native_buffer_spec = {
+  "pyeclib_c.NativeBuffer",
+  sizeof(pyeclib_native_buffer_t),
+  0,
+  Py_TPFLAGS_DEFAULT,
+  native_buffer_slots,
+};
+
+/**
+ * Return a read-only memoryview of native memory kept alive by owner.
+ *
+ * @param owner capsule returned by native_result_new()
+ * @param buf start of the region to expose
+ * @param len length in bytes of the region
+ * @return new memoryview reference, or NULL on error
+ */
+static PyObject *
+native_memoryview(PyObject *owner, char *buf, Py_ssize_t len)
+{
+  pyeclib_native_buffer_t *exporter;
+  PyObject *view;
+
+  exporter = PyObject_New(pyeclib_native_buffer_t, NativeBufferType);
+  if (NULL == exporter) {
+    return NULL;
+  }
+  Py_INCREF(owner);
+  exporter->owner = owner;
+  exporter->buf = buf;
+  exporter->len = len;
+
+  view = PyMemoryView_FromObject((PyObject *) exporter);
+  Py_DECREF(exporter);
+  return view;
+}
+
+/**
+ * Minimal fork-join helper for running independent native tasks in parallel.
+ *
+ * run_tasks() calls fn(ctx, i) once for every i in [0, num_tasks), spread
+ * over up to num_threads threads, the calling thread included, and returns
+ * once all of them are done.  No more threads are used than there are
+ * online CPUs, as the tasks are CPU bound.  Tasks are handed out one at a
+ * time, so uneven task costs balance out.  fn must not touch Python objects: callers
+ * release the GIL around run_tasks().  If threads cannot be created the
+ * remaining work simply runs on fewer threads.
+ */
+typedef void (*pyeclib_task_fn)(void *ctx, int idx);
+
+typedef struct pyeclib_task_pool_s {
+  pyeclib_task_fn fn;
+  void *ctx;
+  int num_tasks;
+  int next_task;
+  pthread_mutex_t lock;
+} pyeclib_task_pool_t;
+
+static void *
+task_worker(void *arg)
+{
+  pyeclib_task_pool_t *pool = (pyeclib_task_pool_t *) arg;
+  int idx;
+
+  for (;;) {
+    pthread_mutex_lock(&pool->lock);
+    idx = pool->next_task++;
+    pthread_mutex_unlock(&pool->lock);
+    if (idx >= pool->num_tasks) {
+      break;
+    }
+    pool->fn(pool->ctx, idx);
+  }
+  return NULL;
+}
+
+static void
+run_tasks(pyeclib_task_fn fn, void *ctx, int num_tasks, int num_threads)
+{
+  pyeclib_task_pool_t pool;
+  pthread_t *threads = NULL;
+  long num_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+  int started = 0;
+  int i;
+
+  if (num_cpus > 0 && num_threads > num_cpus) {
+    num_threads = (int) num_cpus;
+  }
+  if (num_threads > num_tasks) {
+    num_threads = num_tasks;
+  }
+  pool.fn = fn;
+  pool.ctx = ctx;
+  pool.num_tasks = num_tasks;
+  pool.next_task = 0;
+  pthread_mutex_init(&pool.lock, NULL);
+
+  if (num_threads > 1) {
+    threads = (pthread_t *) malloc(sizeof(pthread_t) * (num_threads - 1));
+  }
+  for (i = 0; NULL != threads && i < num_threads - 1; i++) {
+    if (pthread_create(&threads[i], NULL, task_worker, &pool) != 0) {
+      break;
+    }
+    started++;
+  }
+  task_worker(&pool);
+  for (i = 0; i < started; i++) {
+    pthread_join(threads[i], NULL);
+  }
+  check_and_free_buffer(threads);
+  pthread_mutex_destroy(&pool.lock);
+}
+
 /**
  * Constructor method for creating a new pyeclib object using the given parameters.
  *
@@ -242,6 +862,9 @@ pyeclib_c_init(PyObject *self, PyObject *args)
     goto cleanup;
   }
 
+  pthread_mutex_init(&pyeclib_handle->lock, NULL);
+  pthread_cond_init(&pyeclib_handle->idle, NULL);
+  pyeclib_handle->backend_id = backend_id;
   pyeclib_handle->ec_args.k = k;
   pyeclib_handle->ec_args.m = m;
   pyeclib_handle->ec_args.hd = hd;
@@ -280,6 +903,10 @@ exit:
   return pyeclib_obj_handle;
 
 cleanup:
+  if (pyeclib_handle) {
+    pthread_mutex_destroy(&pyeclib_handle->lock);
+    pthread_cond_destroy(&pyeclib_handle->idle);
+  }
   check_and_free_buffer(pyeclib_handle);
   pyeclib_obj_handle = NULL;
   goto exit;
@@ -314,6 +941,37 @@ _destroy(PyObject *obj, int in_destructor)
      */
     return pyeclib_handle;
   }
+  if (!in_destructor) {
+    /*
+     * Other threads may still be using the handle; refuse new calls and
+     * wait for the ones in flight to finish before the instance goes away.
+     * Nothing can be in flight once the destructor runs, since every call
+     * holds a reference to the capsule.
+     */
+    int already_destroyed;
+    int results;
+
+    Py_BEGIN_ALLOW_THREADS
+    pthread_mutex_lock(&pyeclib_handle->lock);
+    already_destroyed = pyeclib_handle->destroyed;
+    pyeclib_handle->destroyed = 1;
+    while (pyeclib_handle->in_flight > 0) {
+      pthread_cond_wait(&pyeclib_handle->idle, &pyeclib_handle->lock);
+    }
+    results = pyeclib_handle->results;
+    pthread_mutex_unlock(&pyeclib_handle->lock);
+    Py_END_ALLOW_THREADS
+
+    if (already_destroyed) {
+      pyeclib_c_seterr(-EBACKENDNOTAVAIL, "pyeclib_c_destroy");
+      return NULL;
+    }
+    if (results > 0) {
+      /* The last zero-copy result destroys the instance once released */
+      return pyeclib_handle;
+    }
+  }
+
   /*
    * Free up the liberasure instance using liberasurecode.
    * If it fails due to wrlock issues, fall back to check_and_free_buffer
@@ -332,97 +990,180 @@ _destroy(PyObject *obj, int in_destructor)
 }
 
 /**
- * Destroy method for cleaning up pyeclib object.
+ * Pin the pyeclib object behind a handle for the duration of a call.
+ *
+ * While pinned, destroy() waits rather than pulling the liberasurecode
+ * instance out from under the call.  Every successful acquire must be
+ * matched by pyeclib_handle_release().
+ *
+ * @param obj handle capsule
+ * @param prefix name of the calling function, used in error messages
+ * @return the pinned object, or NULL with an exception set if the handle is
+ *         invalid or has been destroyed
  */
-static PyObject *
-pyeclib_c_destroy(PyObject *self, PyObject *obj)
+static pyeclib_t *
+pyeclib_handle_acquire(PyObject *obj, const char *prefix)
 {
-  if (_destroy(obj, 0) == NULL) {
+  pyeclib_t *pyeclib_handle;
+  int destroyed;
+
+  pyeclib_handle = (pyeclib_t*)PyCapsule_GetPointer(obj, PYECC_HANDLE_NAME);
+  if (pyeclib_handle == NULL) {
+    pyeclib_c_seterr(-EINVALIDPARAMS, prefix);
     return NULL;
   }
-  Py_RETURN_NONE;
-}
 
+  pthread_mutex_lock(&pyeclib_handle->lock);
+  destroyed = pyeclib_handle->destroyed;
+  if (!destroyed) {
+    pyeclib_handle->in_flight++;
+  }
+  pthread_mutex_unlock(&pyeclib_handle->lock);
+
+  if (destroyed) {
+    pyeclib_c_seterr(-EBACKENDNOTAVAIL, prefix);
+    return NULL;
+  }
+  return pyeclib_handle;
+}
 
-/**
- * Destructor method for cleaning up pyeclib object.
- */
 static void
-pyeclib_c_destructor(PyObject *obj)
+pyeclib_handle_release(pyeclib_t *pyeclib_handle)
 {
-  pyeclib_t *pyeclib_handle = _destroy(obj, 1);
-  check_and_free_buffer(pyeclib_handle);
+  pthread_mutex_lock(&pyeclib_handle->lock);
+  if (--pyeclib_handle->in_flight == 0) {
+    pthread_cond_broadcast(&pyeclib_handle->idle);
+  }
+  pthread_mutex_unlock(&pyeclib_handle->lock);
 }
 
-
 /**
- * This function takes data length and a segment size and returns an object
- * containing:
- *
- * segment_size: size of the payload to give to encode()
- * last_segment_size: size of the payload to give to encode()
- * fragment_size: the fragment size returned by encode()
- * last_fragment_size: the fragment size returned by encode()
- * num_segments: number of segments
- *
- * This allows the caller to prepare requests when segmenting a data stream
- * to be EC'd.
- *
- * Since the data length will rarely be aligned to the segment size, the last
- * segment will be a different size than the others.
- *
- * There are restrictions on the length given to encode(), so calling this
- * before encode is highly recommended when segmenting a data stream.
- *
- * Minimum segment size depends on the underlying EC type (if it is less
- * than this, then the last segment will be slightly larger than the others,
- * otherwise it will be smaller).
- *
- * @param pyeclib_obj_handle
- * @param data_len integer length of data in bytes
- * @param segment_size integer length of segment in bytes
- * @return a python dictionary with segment information
+ * Run a method that takes a handle as its first argument with that handle
+ * pinned.  Argument errors are left for the method itself to report.
  *
+ * Unless op is negative, the call is also counted in the handle's stats.
  */
 static PyObject *
-pyeclib_c_get_segment_info(PyObject *self, PyObject *args)
+call_pinned(PyCFunction method, PyObject *self, PyObject *args,
+            int op, const char *prefix)
 {
-  PyObject *pyeclib_obj_handle = NULL;
-  pyeclib_t *pyeclib_handle = NULL;
-  PyObject *ret_dict = NULL;               /* python dictionary to return */
+  pyeclib_t *pyeclib_handle;
+  pyeclib_call_t call;
+  PyObject *obj;
+  PyObject *ret;
 
-  int data_len;                            /* data length from user in bytes */
-  int segment_size, last_segment_size;     /* segment sizes in bytes */
-  int num_segments;                        /* total number of segments */
-  int fragment_size, last_fragment_size;   /* fragment sizes in bytes */
-  int min_segment_size;                    /* EC algorithm's min. size (B) */
+  if (!PyTuple_Check(args) || PyTuple_GET_SIZE(args) < 1) {
+    return method(self, args);
+  }
+  obj = PyTuple_GET_ITEM(args, 0);
+  if (!PyCapsule_IsValid(obj, PYECC_HANDLE_NAME)) {
+    return method(self, args);
+  }
 
-  /* Obtain and validate the method parameters */
-  if (!PyArg_ParseTuple(args, "Oii", &pyeclib_obj_handle, &data_len, &segment_size)) {
-    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_get_segment_info");
+  pyeclib_handle = pyeclib_handle_acquire(obj, prefix);
+  if (NULL == pyeclib_handle) {
     return NULL;
   }
-  pyeclib_handle = (pyeclib_t*)PyCapsule_GetPointer(pyeclib_obj_handle, PYECC_HANDLE_NAME);
-  if (pyeclib_handle == NULL) {
-    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_get_segment_info");
+  if (op < 0) {
+    ret = method(self, args);
+  } else {
+    stats_call_begin(&call, pyeclib_handle, (pyeclib_op_t) op);
+    ret = method(self, args);
+    if (NULL != ret) {
+      stats_count_result(ret);
+    }
+    stats_call_end(&call, NULL == ret);
+  }
+  pyeclib_handle_release(pyeclib_handle);
+  return ret;
+}
+
+#define PINNED_METHOD(method, op)                               \
+  static PyObject *                                             \
+  method##_pinned(PyObject *self, PyObject *args)               \
+  {                                                             \
+    return call_pinned(method, self, args, op, #method);        \
+  }
+
+/**
+ * Destroy method for cleaning up pyeclib object.
+ */
+static PyObject *
+pyeclib_c_destroy(PyObject *self, PyObject *obj)
+{
+  if (_destroy(obj, 0) == NULL) {
     return NULL;
   }
+  Py_RETURN_NONE;
+}
+
+
+/**
+ * Destructor method for cleaning up pyeclib object.
+ */
+static void
+pyeclib_c_destructor(PyObject *obj)
+{
+  pyeclib_t *pyeclib_handle = _destroy(obj, 1);
+  if (pyeclib_handle) {
+    pthread_mutex_destroy(&pyeclib_handle->lock);
+    pthread_cond_destroy(&pyeclib_handle->idle);
+  }
+  check_and_free_buffer(pyeclib_handle);
+}
+
+
+typedef struct pyeclib_segment_info_s {
+  int segment_size;                 /* size of all but the last segment */
+  int last_segment_size;
+  int fragment_size;                /* including the fragment header */
+  int last_fragment_size;
+  int num_segments;
+} pyeclib_segment_info_t;
+
+/**
+ * Work out how a payload is split into segments for encoding.
+ *
+ * This is the layout reported by get_segment_info(); see there for the
+ * rules.  Anything that segments data natively must use it, so that the
+ * results agree with what callers computed up front.
+ *
+ * @param pyeclib_handle
+ * @param data_len length of the payload in bytes
+ * @param segment_size requested segment size in bytes
+ * @param info out param, the resulting layout
+ * @return 0 on success, or a negative error code
+ */
+static int
+get_segment_layout(pyeclib_t *pyeclib_handle, int64_t data_len,
+                   int segment_size, pyeclib_segment_info_t *info)
+{
+  int64_t num_segments;                    /* total number of segments */
+  int64_t last_segment_size;
+  int fragment_size, last_fragment_size;   /* fragment sizes in bytes */
+  int min_segment_size;                    /* EC algorithm's min. size (B) */
+
+  if (segment_size <= 0) {
+    return -EINVALIDPARAMS;
+  }
 
   /* The minimum segment size depends on the EC algorithm */
   min_segment_size = liberasurecode_get_minimum_encode_size(pyeclib_handle->ec_desc);
   if (min_segment_size < 0) {
-    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_get_segment_info");
-    return NULL;
+    return -EINVALIDPARAMS;
   }
 
   /* Get the number of segments */
-  num_segments = (int)ceill((double)data_len / segment_size);
+  num_segments = (data_len + segment_size - 1) / segment_size;
+  if (num_segments > INT_MAX) {
+    return -EINVALIDPARAMS;
+  }
 
   /*
    * If there are two segments and the last is smaller than the
    * minimum size, then combine into a single segment
    */
-  if (num_segments == 2 && data_len < (segment_size + min_segment_size)) {
+  if (num_segments == 2 && data_len < ((int64_t) segment_size + min_segment_size)) {
     num_segments--;
   }
 
@@ -440,12 +1181,11 @@ pyeclib_c_get_segment_info(PyObject *self, PyObject *args)
 
     fragment_size = liberasurecode_get_fragment_size(pyeclib_handle->ec_desc, data_len);
     if (fragment_size < 0) {
-      pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_get_segment_info");
-      return NULL;
+      return -EINVALIDPARAMS;
     }
 
     /* Segment size is the user-provided segment size */
-    segment_size = data_len;
+    segment_size = (int) data_len;
     last_fragment_size = fragment_size;
     last_segment_size = segment_size;
   } else {
@@ -456,11 +1196,10 @@ pyeclib_c_get_segment_info(PyObject *self, PyObject *args)
 
     fragment_size = liberasurecode_get_fragment_size(pyeclib_handle->ec_desc, segment_size);
     if (fragment_size < 0) {
-      pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_get_segment_info");
-      return NULL;
+      return -EINVALIDPARAMS;
     }
 
-    last_segment_size = data_len - (segment_size * (num_segments - 1));
+    last_segment_size = data_len - ((int64_t) segment_size * (num_segments - 1));
 
     /*
      * The last segment is lower than the minimum size, so combine it
@@ -475,24 +1214,85 @@ pyeclib_c_get_segment_info(PyObject *self, PyObject *args)
     }
 
     last_fragment_size = liberasurecode_get_fragment_size(pyeclib_handle->ec_desc, last_segment_size);
-    if (fragment_size < 0) {
-      pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_get_segment_info");
-      return NULL;
+    if (last_fragment_size < 0) {
+      return -EINVALIDPARAMS;
     }
   }
 
   /* Add header to fragment sizes */
-  last_fragment_size += sizeof(fragment_header_t);
-  fragment_size += sizeof(fragment_header_t);
+  info->segment_size = segment_size;
+  info->last_segment_size = (int) last_segment_size;
+  info->fragment_size = fragment_size + sizeof(fragment_header_t);
+  info->last_fragment_size = last_fragment_size + sizeof(fragment_header_t);
+  info->num_segments = (int) num_segments;
+  return 0;
+}
+
+/**
+ * This function takes data length and a segment size and returns an object
+ * containing:
+ *
+ * segment_size: size of the payload to give to encode()
+ * last_segment_size: size of the payload to give to encode()
+ * fragment_size: the fragment size returned by encode()
+ * last_fragment_size: the fragment size returned by encode()
+ * num_segments: number of segments
+ *
+ * This allows the caller to prepare requests when segmenting a data stream
+ * to be EC'd.
+ *
+ * Since the data length will rarely be aligned to the segment size, the last
+ * segment will be a different size than the others.
+ *
+ * There are restrictions on the length given to encode(), so calling this
+ * before encode is highly recommended when segmenting a data stream.
+ *
+ * Minimum segment size depends on the underlying EC type (if it is less
+ * than this, then the last segment will be slightly larger than the others,
+ * otherwise it will be smaller).
+ *
+ * @param pyeclib_obj_handle
+ * @param data_len integer length of data in bytes
+ * @param segment_size integer length of segment in bytes
+ * @return a python dictionary with segment information
+ *
+ */
+static PyObject *
+pyeclib_c_get_segment_info(PyObject *self, PyObject *args)
+{
+  PyObject *pyeclib_obj_handle = NULL;
+  pyeclib_t *pyeclib_handle = NULL;
+  PyObject *ret_dict = NULL;               /* python dictionary to return */
+  pyeclib_segment_info_t info;             /* computed segment layout */
+  int data_len;                            /* data length from user in bytes */
+  int segment_size;                        /* segment size in bytes */
+  int ret;
+
+  /* Obtain and validate the method parameters */
+  if (!PyArg_ParseTuple(args, "Oii", &pyeclib_obj_handle, &data_len, &segment_size)) {
+    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_get_segment_info");
+    return NULL;
+  }
+  pyeclib_handle = (pyeclib_t*)PyCapsule_GetPointer(pyeclib_obj_handle, PYECC_HANDLE_NAME);
+  if (pyeclib_handle == NULL) {
+    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_get_segment_info");
+    return NULL;
+  }
+
+  ret = get_segment_layout(pyeclib_handle, data_len, segment_size, &info);
+  if (ret < 0) {
+    pyeclib_c_seterr(ret, "pyeclib_c_get_segment_info");
+    return NULL;
+  }
 
   /* Create and return the python dictionary of segment info */
   ret_dict = Py_BuildValue(
     "{s:i, s:i, s:i, s:i, s:i}",
-    "segment_size", segment_size,
-    "last_segment_size", last_segment_size,
-    "fragment_size", fragment_size,
-    "last_fragment_size", last_fragment_size,
-    "num_segments", num_segments);
+    "segment_size", info.segment_size,
+    "last_segment_size", info.last_segment_size,
+    "fragment_size", info.fragment_size,
+    "last_fragment_size", info.last_fragment_size,
+    "num_segments", info.num_segments);
   if (NULL == ret_dict) {
     pyeclib_c_seterr(-ENOMEM, "pyeclib_c_get_segment_info");
     return NULL;
@@ -507,6 +1307,8 @@ pyeclib_c_get_segment_info(PyObject *self, PyObject *args)
  *
  * @param pyeclib_obj_handle
  * @param data to encode
+ * @param zero_copy (optional) return read-only memoryviews of the buffers
+ *        allocated by liberasurecode instead of copying them into bytes
  * @return python list of encoded data and parity elements
  */
 static PyObject *
@@ -517,185 +1319,716 @@ pyeclib_c_encode(PyObject *self, PyObject *args)
   char **encoded_data = NULL;     /* array of k data buffers */
   char **encoded_parity = NULL;     /* array of m parity buffers */
   PyObject *list_of_strips = NULL;  /* list of encoded strips to return */
-  char *data;                       /* param, data buffer to encode */
-  Py_ssize_t data_len;              /* param, length of data buffer */
-  uint64_t fragment_len;            /* length, in bytes of the fragments */
+  PyObject *owner = NULL;           /* keeps zero-copy fragments alive */
+  pyeclib_native_result_t *result = NULL;
+  Py_buffer data;                   /* param, data buffer to encode */
+  uint64_t fragment_len = 0;        /* length, in bytes of the fragments */
+  int zero_copy = 0;                /* param, return memoryviews */
+  int k, m;
   int i;                            /* a counter */
   int ret = 0;
 
-  /* Assume binary data (force "byte array" input) */
-  if (!PyArg_ParseTuple(args, ENCODE_ARGS, &pyeclib_obj_handle, &data, &data_len)) {
+  /* Accept any contiguous buffer (bytes, bytearray, memoryview, mmap, ...) */
+  if (!PyArg_ParseTuple(args, ENCODE_ARGS, &pyeclib_obj_handle, &data, &zero_copy)) {
     pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_encode");
     return NULL;
   }
   pyeclib_handle = (pyeclib_t*)PyCapsule_GetPointer(pyeclib_obj_handle, PYECC_HANDLE_NAME);
   if (pyeclib_handle == NULL) {
     pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_encode");
+    PyBuffer_Release(&data);
     return NULL;
   }
-
-  ret = liberasurecode_encode(pyeclib_handle->ec_desc, data, data_len, &encoded_data, &encoded_parity, &fragment_len);
+  k = pyeclib_handle->ec_args.k;
+  m = pyeclib_handle->ec_args.m;
+  stats_count_in(data.len);
+  PYECLIB_PROBE(encode_entry, PYECLIB_PROBE_HANDLE(pyeclib_handle), data.len);
+
+  /* The buffer export keeps data alive, so it's safe to drop the GIL */
+  PYECLIB_BEGIN_NATIVE
+  ret = liberasurecode_encode(pyeclib_handle->ec_desc, data.buf, data.len, &encoded_data, &encoded_parity, &fragment_len);
+  PYECLIB_END_NATIVE
+  PyBuffer_Release(&data);
   if (ret < 0) {
     pyeclib_c_seterr(ret, "pyeclib_c_encode");
+    PYECLIB_PROBE(encode_return, PYECLIB_PROBE_HANDLE(pyeclib_handle),
+                  fragment_len, ret);
     return NULL;
   }
 
+  if (zero_copy) {
+    /* Hand ownership of the fragments to a capsule shared by the views */
+    result = (pyeclib_native_result_t *) alloc_zeroed_buffer(sizeof(pyeclib_native_result_t));
+    if (NULL == result) {
+      pyeclib_c_seterr(-ENOMEM, "pyeclib_c_encode");
+      liberasurecode_encode_cleanup(pyeclib_handle->ec_desc, encoded_data, encoded_parity);
+      PYECLIB_PROBE(encode_return, PYECLIB_PROBE_HANDLE(pyeclib_handle),
+                    fragment_len, -ENOMEM);
+      return NULL;
+    }
+    native_result_pin(result, pyeclib_obj_handle, pyeclib_handle);
+    result->encoded_data = encoded_data;
+    result->encoded_parity = encoded_parity;
+    owner = native_result_new(result);
+    if (NULL == owner) {
+      PYECLIB_PROBE(encode_return, PYECLIB_PROBE_HANDLE(pyeclib_handle),
+                    fragment_len, -1);
+      return NULL;
+    }
+  }
+
   /* Create the python list of fragments to return */
-  list_of_strips = PyList_New(pyeclib_handle->ec_args.k + pyeclib_handle->ec_args.m);
+  list_of_strips = PyList_New(k + m);
   if (NULL == list_of_strips) {
     pyeclib_c_seterr(-ENOMEM, "pyeclib_c_encode");
-    return NULL;
+    goto exit;
   }
 
-  /* Add data fragments to the python list to return */
-  for (i = 0; i < pyeclib_handle->ec_args.k; i++) {
-    PyList_SetItem(list_of_strips, i,
-                    PY_BUILDVALUE_OBJ_LEN(encoded_data[i], fragment_len));
-  }
+  for (i = 0; i < k + m; i++) {
+    char *fragment = (i < k) ? encoded_data[i] : encoded_parity[i - k];
+    PyObject *item;
 
-  /* Add parity fragments to the python list to return */
-  for (i = 0; i < pyeclib_handle->ec_args.m; i++) {
-    PyList_SetItem(list_of_strips, pyeclib_handle->ec_args.k + i,
-                    PY_BUILDVALUE_OBJ_LEN(encoded_parity[i], fragment_len));
+    if (NULL != owner) {
+      item = native_memoryview(owner, fragment, fragment_len);
+    } else {
+      item = PY_BUILDVALUE_OBJ_LEN(fragment, fragment_len);
+    }
+    if (NULL == item) {
+      Py_CLEAR(list_of_strips);
+      goto exit;
+    }
+    PyList_SetItem(list_of_strips, i, item);
   }
 
-  liberasurecode_encode_cleanup(pyeclib_handle->ec_desc, encoded_data, encoded_parity);
+exit:
+  if (NULL != owner) {
+    Py_DECREF(owner);
+  } else {
+    liberasurecode_encode_cleanup(pyeclib_handle->ec_desc, encoded_data, encoded_parity);
+  }
 
+  PYECLIB_PROBE(encode_return, PYECLIB_PROBE_HANDLE(pyeclib_handle),
+                fragment_len, PYECLIB_PROBE_RC(list_of_strips, ret));
   return list_of_strips;
 }
 
 
 /**
- * Return a list of lists with valid rebuild indexes given an EC algorithm
- * and a list of missing indexes.
+ * Erasure encode a data buffer into caller-supplied fragment buffers.
+ *
+ * Unlike encode(), no Python objects are allocated for the fragments; the
+ * caller can reuse the same writable buffers (bytearray, mmap, shared
+ * memory, ...) across requests.
  *
  * @param pyeclib_obj_handle
- * @param reconstruct_list list of missing fragments to reconstruct
- * @param exclude_list list of fragments to exclude from reconstruction
- * @return a list of lists of indexes to rebuild data from
+ * @param data to encode
+ * @param outputs list of k + m writable buffers, each at least as large as
+ *        the fragment size reported by get_segment_info()
+ * @return python int, the number of bytes written to each output buffer
  */
 static PyObject *
-pyeclib_c_get_required_fragments(PyObject *self, PyObject *args)
+pyeclib_c_encode_into(PyObject *self, PyObject *args)
 {
   PyObject *pyeclib_obj_handle = NULL;
   pyeclib_t *pyeclib_handle = NULL;
-  PyObject *reconstruct_list = NULL;        /* list of missing fragments to reconstruct */
-  PyObject *exclude_list = NULL;        /* list of fragments to exclude from reconstruction */
-  PyObject *fragment_idx_list = NULL;   /* list of req'd indexes to return */
-  int *c_reconstruct_list = NULL;           /* c-array of missing indexes */
-  int *c_exclude_list = NULL;           /* c-array of missing indexes */
-  int num_missing;                      /* size of passed in missing list */
-  int num_exclude;                      /* size of passed in exclude list */
-  int i = 0;                            /* counters */
-  int k, m;                             /* EC algorithm parameters */
-  int *fragments_needed = NULL;         /* indexes of xor code fragments */
-  int ret;                              /* return value for xor code */
+  PyObject *outputs = NULL;         /* param, list of output buffers */
+  Py_buffer *output_views = NULL;   /* buffers backing c_outputs */
+  char **c_outputs = NULL;          /* C array of output buffers */
+  char **encoded_data = NULL;       /* array of k data buffers */
+  char **encoded_parity = NULL;     /* array of m parity buffers */
+  Py_buffer data;                   /* param, data buffer to encode */
+  uint64_t fragment_len = 0;        /* length, in bytes of the fragments */
+  PyObject *ret_obj = NULL;         /* python int to return */
+  int num_fragments = 0;            /* k + m */
+  int i;                            /* a counter */
+  int ret = 0;
 
-  /* Obtain and validate the method parameters */
-  if (!PyArg_ParseTuple(args, "OOO", &pyeclib_obj_handle, &reconstruct_list, &exclude_list)) {
-    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_get_required_fragments");
+  if (!PyArg_ParseTuple(args, "Oy*O", &pyeclib_obj_handle, &data, &outputs)) {
+    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_encode_into");
     return NULL;
   }
   pyeclib_handle = (pyeclib_t*)PyCapsule_GetPointer(pyeclib_obj_handle, PYECC_HANDLE_NAME);
   if (pyeclib_handle == NULL) {
-    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_get_required_fragments");
-    return NULL;
-  }
-  k = pyeclib_handle->ec_args.k;
-  m = pyeclib_handle->ec_args.m;
-
-  /* Generate -1 terminated c-array and bitmap of missing indexes */
-  num_missing = (int) PyList_Size(reconstruct_list);
-  c_reconstruct_list = (int *) alloc_zeroed_buffer((num_missing + 1) * sizeof(int));
-  if (NULL == c_reconstruct_list) {
-    pyeclib_c_seterr(-ENOMEM, "pyeclib_c_get_required_fragments");
-    return NULL;
-  }
-  c_reconstruct_list[num_missing] = -1;
-  for (i = 0; i < num_missing; i++) {
-    PyObject *obj_idx = PyList_GetItem(reconstruct_list, i);
-    long idx = PyLong_AsLong(obj_idx);
-    c_reconstruct_list[i] = (int) idx;
-  }
-
-  num_exclude = (int) PyList_Size(exclude_list);
-  c_exclude_list = (int *) alloc_zeroed_buffer((num_exclude + 1) * sizeof(int));
-  if (NULL == c_exclude_list) {
-    pyeclib_c_seterr(-ENOMEM, "pyeclib_c_get_required_fragments");
+    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_encode_into");
     goto exit;
   }
-  c_exclude_list[num_exclude] = -1;
-  for (i = 0; i < num_exclude; i++) {
-    PyObject *obj_idx = PyList_GetItem(exclude_list, i);
-    long idx = PyLong_AsLong(obj_idx);
-    c_exclude_list[i] = (int) idx;
+  num_fragments = pyeclib_handle->ec_args.k + pyeclib_handle->ec_args.m;
+  if (!PyList_Check(outputs) || PyList_Size(outputs) != num_fragments) {
+    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_encode_into");
+    goto exit;
   }
 
-  fragments_needed = alloc_zeroed_buffer(sizeof(int) * (k + m));
-  if (NULL == fragments_needed) {
-    pyeclib_c_seterr(-ENOMEM, "pyeclib_c_get_required_fragments");
+  c_outputs = (char **) alloc_zeroed_buffer(sizeof(char *) * num_fragments);
+  if (NULL == c_outputs) {
+    pyeclib_c_seterr(-ENOMEM, "pyeclib_c_encode_into");
     goto exit;
   }
-
-  ret = liberasurecode_fragments_needed(pyeclib_handle->ec_desc, c_reconstruct_list,
-                                        c_exclude_list, fragments_needed);
+  ret = get_fragment_buffers(outputs, num_fragments, 0, PyBUF_WRITABLE,
+                             &output_views, c_outputs);
   if (ret < 0) {
-    pyeclib_c_seterr(ret, "pyeclib_c_get_required_fragments");
+    pyeclib_c_seterr(ret, "pyeclib_c_encode_into");
     goto exit;
   }
 
-  /* Post-process into a Python list */
-  fragment_idx_list = PyList_New(0);
-  if (NULL == fragment_idx_list) {
-    pyeclib_c_seterr(-ENOMEM, "pyeclib_c_get_required_fragments");
-    goto exit;
+  PYECLIB_BEGIN_NATIVE
+  ret = liberasurecode_encode(pyeclib_handle->ec_desc, data.buf, data.len,
+                              &encoded_data, &encoded_parity, &fragment_len);
+  if (ret == 0) {
+    for (i = 0; i < num_fragments; i++) {
+      if ((uint64_t) output_views[i].len < fragment_len) {
+        ret = -EINVALIDPARAMS;
+        break;
+      }
+    }
+  }
+  if (ret == 0) {
+    for (i = 0; i < pyeclib_handle->ec_args.k; i++) {
+      memcpy(c_outputs[i], encoded_data[i], fragment_len);
+    }
+    for (i = 0; i < pyeclib_handle->ec_args.m; i++) {
+      memcpy(c_outputs[pyeclib_handle->ec_args.k + i], encoded_parity[i], fragment_len);
+    }
   }
+  if (encoded_data != NULL || encoded_parity != NULL) {
+    liberasurecode_encode_cleanup(pyeclib_handle->ec_desc, encoded_data, encoded_parity);
+  }
+  PYECLIB_END_NATIVE
 
-  for (i = 0; fragments_needed[i] > -1; i++) {
-    PyList_Append(fragment_idx_list, Py_BuildValue("i", fragments_needed[i]));
+  if (ret < 0) {
+    pyeclib_c_seterr(ret, "pyeclib_c_encode_into");
+    goto exit;
   }
+  stats_count_in(data.len);
+  stats_count_out(fragment_len * num_fragments, 0);
+  ret_obj = PyLong_FromUnsignedLongLong(fragment_len);
 
 exit:
-  check_and_free_buffer(c_reconstruct_list);
-  check_and_free_buffer(c_exclude_list);
-  check_and_free_buffer(fragments_needed);
-
-  return fragment_idx_list;
+  release_fragment_buffers(output_views, num_fragments);
+  check_and_free_buffer(c_outputs);
+  PyBuffer_Release(&data);
+  return ret_obj;
 }
 
 
 /**
- * Reconstruct a missing fragment from the the remaining fragments.
+ * Erasure encode a batch of data buffers in a single call.
  *
- * TODO: If we are reconstructing a parity element, ensure that all of the
- * data elements are available!
+ * Items are encoded one after another with the GIL released, which
+ * amortizes the per-call overhead of crossing into C over many small
+ * segments.  The GIL is taken back after every BATCH_CHUNK_BYTES of input to
+ * turn that chunk's fragments into bytes and free liberasurecode's copies,
+ * so large items cost about the same as encoding them one call at a time.
+ * An error encoding one item does not affect the others; it is returned in
+ * place of that item's fragments.
  *
  * @param pyeclib_obj_handle
- * @param data_list k length list of data elements
- * @param parity_list m length list of parity elements
- * @param missing_idx_list list of the indexes of missing elements
- * @param destination_idx index of fragment to reconstruct
- * @param fragment_size size in bytes of the fragments
- * @return reconstructed destination fragment or NULL on error
+ * @param data_list list of data buffers to encode
+ * @return python list with, per item, either a list of k + m fragments or
+ *         the pyeclib exception describing why encoding it failed
  */
 static PyObject *
-pyeclib_c_reconstruct(PyObject *self, PyObject *args)
+pyeclib_c_encode_many(PyObject *self, PyObject *args)
 {
   PyObject *pyeclib_obj_handle = NULL;
   pyeclib_t *pyeclib_handle = NULL;
-  PyObject *fragments = NULL;           /* param, list of fragments */
-  PyObject *reconstructed = NULL;       /* reconstructed object to return */
-  char * c_reconstructed = NULL;        /* C string of reconstructed fragment */
+  PyObject *data_list = NULL;       /* param, list of data buffers */
+  Py_buffer *data_views = NULL;     /* buffers backing c_data */
+  char **c_data = NULL;             /* C array of data buffers */
+  char ***encoded_data = NULL;      /* per item, array of k data buffers */
+  char ***encoded_parity = NULL;    /* per item, array of m parity buffers */
+  uint64_t *fragment_lens = NULL;   /* per item, length of the fragments */
+  int *rets = NULL;                 /* per item, encode return value */
+  PyObject *results = NULL;         /* python list to return */
+  int num_items = 0;
+  int start, end;                   /* chunk of items being encoded */
+  int k, m;
+  int i;
+  int ret;
+
+  if (!PyArg_ParseTuple(args, "OO", &pyeclib_obj_handle, &data_list)) {
+    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_encode_many");
+    return NULL;
+  }
+  pyeclib_handle = (pyeclib_t*)PyCapsule_GetPointer(pyeclib_obj_handle, PYECC_HANDLE_NAME);
+  if (pyeclib_handle == NULL || !PyList_Check(data_list)) {
+    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_encode_many");
+    return NULL;
+  }
+  k = pyeclib_handle->ec_args.k;
+  m = pyeclib_handle->ec_args.m;
+  num_items = PyList_Size(data_list);
+  if (num_items == 0) {
+    return PyList_New(0);
+  }
+
+  c_data = (char **) alloc_zeroed_buffer(sizeof(char *) * num_items);
+  encoded_data = (char ***) alloc_zeroed_buffer(sizeof(char **) * num_items);
+  encoded_parity = (char ***) alloc_zeroed_buffer(sizeof(char **) * num_items);
+  fragment_lens = (uint64_t *) alloc_zeroed_buffer(sizeof(uint64_t) * num_items);
+  rets = (int *) alloc_zeroed_buffer(sizeof(int) * num_items);
+  if (NULL == c_data || NULL == encoded_data || NULL == encoded_parity ||
+      NULL == fragment_lens || NULL == rets) {
+    pyeclib_c_seterr(-ENOMEM, "pyeclib_c_encode_many");
+    goto exit;
+  }
+  ret = get_fragment_buffers(data_list, num_items, 0, PyBUF_SIMPLE,
+                             &data_views, c_data);
+  if (ret < 0) {
+    pyeclib_c_seterr(ret, "pyeclib_c_encode_many");
+    goto exit;
+  }
+
+  results = PyList_New(num_items);
+  if (NULL == results) {
+    pyeclib_c_seterr(-ENOMEM, "pyeclib_c_encode_many");
+    goto exit;
+  }
+
+  for (start = 0; start < num_items; start = end) {
+    uint64_t chunk_bytes = 0;
+
+    end = start;
+    PYECLIB_BEGIN_NATIVE
+    do {
+      rets[end] = liberasurecode_encode(pyeclib_handle->ec_desc, c_data[end],
+                                        data_views[end].len, &encoded_data[end],
+                                        &encoded_parity[end], &fragment_lens[end]);
+      chunk_bytes += data_views[end].len;
+      end++;
+    } while (end < num_items && chunk_bytes < BATCH_CHUNK_BYTES);
+    PYECLIB_END_NATIVE
+
+    for (i = start; i < end; i++) {
+      PyObject *item;
+
+      if (rets[i] < 0) {
+        stats_count_item_error(rets[i]);
+        item = pyeclib_c_error(rets[i], "pyeclib_c_encode_many");
+      } else {
+        item = encoded_fragments_to_list(k, m, encoded_data[i],
+                                         encoded_parity[i], fragment_lens[i]);
+      }
+      if (NULL != encoded_data[i] || NULL != encoded_parity[i]) {
+        liberasurecode_encode_cleanup(pyeclib_handle->ec_desc,
+                                      encoded_data[i], encoded_parity[i]);
+        encoded_data[i] = NULL;
+        encoded_parity[i] = NULL;
+      }
+      if (NULL == item) {
+        Py_CLEAR(results);
+        goto exit;
+      }
+      PyList_SetItem(results, i, item);
+    }
+  }
+
+exit:
+  for (i = 0; NULL != encoded_data && i < num_items; i++) {
+    if (NULL != encoded_data[i] || NULL != encoded_parity[i]) {
+      liberasurecode_encode_cleanup(pyeclib_handle->ec_desc,
+                                    encoded_data[i], encoded_parity[i]);
+    }
+  }
+  release_fragment_buffers(data_views, num_items);
+  check_and_free_buffer(c_data);
+  check_and_free_buffer(encoded_data);
+  check_and_free_buffer(encoded_parity);
+  check_and_free_buffer(fragment_lens);
+  check_and_free_buffer(rets);
+  return results;
+}
+
+
+/**
+ * Per-call state for pyeclib_c_encode_segments()
+ */
+typedef struct pyeclib_encode_segments_s {
+  int ec_desc;
+  const char *data;
+  pyeclib_segment_info_t info;
+  char ***encoded_data;             /* per segment, array of k data buffers */
+  char ***encoded_parity;           /* per segment, array of m parity buffers */
+  uint64_t *fragment_lens;          /* per segment, length of the fragments */
+  int *rets;                        /* per segment, encode return value */
+} pyeclib_encode_segments_t;
+
+static void
+encode_segment_task(void *arg, int idx)
+{
+  pyeclib_encode_segments_t *ctx = (pyeclib_encode_segments_t *) arg;
+  int64_t offset = (int64_t) idx * ctx->info.segment_size;
+  int len = (idx == ctx->info.num_segments - 1) ?
+    ctx->info.last_segment_size : ctx->info.segment_size;
+
+  ctx->rets[idx] = liberasurecode_encode(ctx->ec_desc, ctx->data + offset, len,
+                                         &ctx->encoded_data[idx],
+                                         &ctx->encoded_parity[idx],
+                                         &ctx->fragment_lens[idx]);
+}
+
+/**
+ * Split a payload into segments and encode them in parallel.
+ *
+ * Segments are laid out as described by get_segment_info() and encoded on
+ * up to num_threads native threads with the GIL released.
+ *
+ * @param pyeclib_obj_handle
+ * @param data payload to encode
+ * @param segment_size requested segment size in bytes
+ * @param num_threads maximum number of threads to encode with
+ * @return python list with, per segment, the list of k + m fragments
+ */
+static PyObject *
+pyeclib_c_encode_segments(PyObject *self, PyObject *args)
+{
+  PyObject *pyeclib_obj_handle = NULL;
+  pyeclib_t *pyeclib_handle = NULL;
+  pyeclib_encode_segments_t ctx;
+  Py_buffer data;                   /* param, data buffer to encode */
+  PyObject *results = NULL;         /* python list to return */
+  int segment_size;                 /* param, requested segment size */
+  int num_threads;                  /* param, number of threads to use */
+  int num_segments = 0;
+  int i;
+  int ret;
+
+  memset(&ctx, 0, sizeof(ctx));
+  if (!PyArg_ParseTuple(args, "Oy*ii", &pyeclib_obj_handle, &data,
+                        &segment_size, &num_threads)) {
+    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_encode_segments");
+    return NULL;
+  }
+  pyeclib_handle = (pyeclib_t*)PyCapsule_GetPointer(pyeclib_obj_handle, PYECC_HANDLE_NAME);
+  if (pyeclib_handle == NULL || num_threads < 1) {
+    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_encode_segments");
+    goto exit;
+  }
+  ret = get_segment_layout(pyeclib_handle, data.len, segment_size, &ctx.info);
+  if (ret < 0) {
+    pyeclib_c_seterr(ret, "pyeclib_c_encode_segments");
+    goto exit;
+  }
+  /* An empty payload is still encoded, as a single empty segment */
+  if (ctx.info.num_segments == 0) {
+    ctx.info.num_segments = 1;
+    ctx.info.segment_size = ctx.info.last_segment_size = 0;
+  }
+  num_segments = ctx.info.num_segments;
+  stats_count_in(data.len);
+
+  ctx.ec_desc = pyeclib_handle->ec_desc;
+  ctx.data = (const char *) data.buf;
+  ctx.encoded_data = (char ***) alloc_zeroed_buffer(sizeof(char **) * num_segments);
+  ctx.encoded_parity = (char ***) alloc_zeroed_buffer(sizeof(char **) * num_segments);
+  ctx.fragment_lens = (uint64_t *) alloc_zeroed_buffer(sizeof(uint64_t) * num_segments);
+  ctx.rets = (int *) alloc_zeroed_buffer(sizeof(int) * num_segments);
+  if (NULL == ctx.encoded_data || NULL == ctx.encoded_parity ||
+      NULL == ctx.fragment_lens || NULL == ctx.rets) {
+    pyeclib_c_seterr(-ENOMEM, "pyeclib_c_encode_segments");
+    goto exit;
+  }
+
+  PYECLIB_BEGIN_NATIVE
+  run_tasks(encode_segment_task, &ctx, num_segments, num_threads);
+  PYECLIB_END_NATIVE
+
+  for (i = 0; i < num_segments; i++) {
+    if (ctx.rets[i] < 0) {
+      pyeclib_c_seterr(ctx.rets[i], "pyeclib_c_encode_segments");
+      goto exit;
+    }
+  }
+
+  results = PyList_New(num_segments);
+  if (NULL == results) {
+    pyeclib_c_seterr(-ENOMEM, "pyeclib_c_encode_segments");
+    goto exit;
+  }
+  for (i = 0; i < num_segments; i++) {
+    PyObject *fragments = encoded_fragments_to_list(pyeclib_handle->ec_args.k,
+                                                    pyeclib_handle->ec_args.m,
+                                                    ctx.encoded_data[i],
+                                                    ctx.encoded_parity[i],
+                                                    ctx.fragment_lens[i]);
+    if (NULL == fragments) {
+      Py_CLEAR(results);
+      goto exit;
+    }
+    PyList_SetItem(results, i, fragments);
+  }
+
+exit:
+  for (i = 0; NULL != ctx.encoded_data && i < num_segments; i++) {
+    if (NULL != ctx.encoded_data[i] || NULL != ctx.encoded_parity[i]) {
+      liberasurecode_encode_cleanup(pyeclib_handle->ec_desc,
+                                    ctx.encoded_data[i], ctx.encoded_parity[i]);
+    }
+  }
+  check_and_free_buffer(ctx.encoded_data);
+  check_and_free_buffer(ctx.encoded_parity);
+  check_and_free_buffer(ctx.fragment_lens);
+  check_and_free_buffer(ctx.rets);
+  PyBuffer_Release(&data);
+  return results;
+}
+
+
+/**
+ * Return a list of lists with valid rebuild indexes given an EC algorithm
+ * and a list of missing indexes.
+ *
+ * @param pyeclib_obj_handle
+ * @param reconstruct_list list of missing fragments to reconstruct
+ * @param exclude_list list of fragments to exclude from reconstruction
+ * @return a list of lists of indexes to rebuild data from
+ */
+static PyObject *
+pyeclib_c_get_required_fragments(PyObject *self, PyObject *args)
+{
+  PyObject *pyeclib_obj_handle = NULL;
+  pyeclib_t *pyeclib_handle = NULL;
+  PyObject *reconstruct_list = NULL;        /* list of missing fragments to reconstruct */
+  PyObject *exclude_list = NULL;        /* list of fragments to exclude from reconstruction */
+  PyObject *fragment_idx_list = NULL;   /* list of req'd indexes to return */
+  int *c_reconstruct_list = NULL;           /* c-array of missing indexes */
+  int *c_exclude_list = NULL;           /* c-array of missing indexes */
+  int num_missing;                      /* size of passed in missing list */
+  int num_exclude;                      /* size of passed in exclude list */
+  int i = 0;                            /* counters */
+  int k, m;                             /* EC algorithm parameters */
+  int *fragments_needed = NULL;         /* indexes of xor code fragments */
+  uint64_t reconstruct_mask = 0;        /* erasure pattern, for the probes */
+  uint64_t exclude_mask = 0;
+  int ret = 0;                          /* return value for xor code */
+
+  /* Obtain and validate the method parameters */
+  if (!PyArg_ParseTuple(args, "OOO", &pyeclib_obj_handle, &reconstruct_list, &exclude_list)) {
+    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_get_required_fragments");
+    return NULL;
+  }
+  pyeclib_handle = (pyeclib_t*)PyCapsule_GetPointer(pyeclib_obj_handle, PYECC_HANDLE_NAME);
+  if (pyeclib_handle == NULL) {
+    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_get_required_fragments");
+    return NULL;
+  }
+  k = pyeclib_handle->ec_args.k;
+  m = pyeclib_handle->ec_args.m;
+  PYECLIB_PROBE(get_required_fragments_entry,
+                PYECLIB_PROBE_HANDLE(pyeclib_handle));
+
+  /* Generate -1 terminated c-array and bitmap of missing indexes */
+  num_missing = (int) PyList_Size(reconstruct_list);
+  c_reconstruct_list = (int *) alloc_zeroed_buffer((num_missing + 1) * sizeof(int));
+  if (NULL == c_reconstruct_list) {
+    pyeclib_c_seterr(-ENOMEM, "pyeclib_c_get_required_fragments");
+    PYECLIB_PROBE(get_required_fragments_return,
+                  PYECLIB_PROBE_HANDLE(pyeclib_handle),
+                  reconstruct_mask, exclude_mask, -ENOMEM);
+    return NULL;
+  }
+  c_reconstruct_list[num_missing] = -1;
+  for (i = 0; i < num_missing; i++) {
+    PyObject *obj_idx = PyList_GetItem(reconstruct_list, i);
+    long idx = PyLong_AsLong(obj_idx);
+    c_reconstruct_list[i] = (int) idx;
+    if (idx >= 0 && idx < 64) {
+      reconstruct_mask |= (uint64_t) 1 << idx;
+    }
+  }
+
+  num_exclude = (int) PyList_Size(exclude_list);
+  c_exclude_list = (int *) alloc_zeroed_buffer((num_exclude + 1) * sizeof(int));
+  if (NULL == c_exclude_list) {
+    pyeclib_c_seterr(-ENOMEM, "pyeclib_c_get_required_fragments");
+    goto exit;
+  }
+  c_exclude_list[num_exclude] = -1;
+  for (i = 0; i < num_exclude; i++) {
+    PyObject *obj_idx = PyList_GetItem(exclude_list, i);
+    long idx = PyLong_AsLong(obj_idx);
+    c_exclude_list[i] = (int) idx;
+    if (idx >= 0 && idx < 64) {
+      exclude_mask |= (uint64_t) 1 << idx;
+    }
+  }
+
+  fragments_needed = alloc_zeroed_buffer(sizeof(int) * (k + m + 1));
+  if (NULL == fragments_needed) {
+    pyeclib_c_seterr(-ENOMEM, "pyeclib_c_get_required_fragments");
+    goto exit;
+  }
+
+  ret = liberasurecode_fragments_needed(pyeclib_handle->ec_desc, c_reconstruct_list,
+                                        c_exclude_list, fragments_needed);
+  if (ret < 0) {
+    pyeclib_c_seterr(ret, "pyeclib_c_get_required_fragments");
+    goto exit;
+  }
+
+  /* Post-process into a Python list */
+  fragment_idx_list = PyList_New(0);
+  if (NULL == fragment_idx_list) {
+    pyeclib_c_seterr(-ENOMEM, "pyeclib_c_get_required_fragments");
+    goto exit;
+  }
+
+  for (i = 0; fragments_needed[i] > -1; i++) {
+    PyList_Append(fragment_idx_list, Py_BuildValue("i", fragments_needed[i]));
+  }
+
+exit:
+  check_and_free_buffer(c_reconstruct_list);
+  check_and_free_buffer(c_exclude_list);
+  check_and_free_buffer(fragments_needed);
+
+  /* The masks only cover indexes below 64 */
+  PYECLIB_PROBE(get_required_fragments_return,
+                PYECLIB_PROBE_HANDLE(pyeclib_handle),
+                reconstruct_mask, exclude_mask,
+                PYECLIB_PROBE_RC(fragment_idx_list, ret));
+  return fragment_idx_list;
+}
+
+
+/* Names of the operation classes reported by get_stats() */
+static const char *stats_op_names[PYECLIB_NUM_OPS] = {
+  "encode",
+  "decode",
+  "reconstruct",
+  "fragments_needed",
+  "metadata",
+  "verify",
+  "other",
+};
+
+/**
+ * Report the per-operation counters of a handle.
+ *
+ * Time is split between native_ns, spent with the GIL released (mostly
+ * inside liberasurecode), and marshal_ns, the rest of the call: argument
+ * parsing, buffer exports and building the result.
+ *
+ * @param pyeclib_obj_handle
+ * @param reset (optional) zero the counters after reading them
+ * @return a python dictionary with an "operations" dictionary of counters
+ *         per operation class, and an "errors" dictionary of failed calls
+ *         per exception class
+ */
+static PyObject *
+pyeclib_c_get_stats(PyObject *self, PyObject *args)
+{
+  PyObject *pyeclib_obj_handle = NULL;
+  pyeclib_t *pyeclib_handle = NULL;
+  PyObject *operations = NULL;
+  PyObject *errors = NULL;
+  PyObject *ret_dict = NULL;
+  int reset = 0;                    /* param, zero the counters */
+  int i;
+
+  if (!PyArg_ParseTuple(args, "O|p", &pyeclib_obj_handle, &reset)) {
+    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_get_stats");
+    return NULL;
+  }
+  pyeclib_handle = (pyeclib_t*)PyCapsule_GetPointer(pyeclib_obj_handle, PYECC_HANDLE_NAME);
+  if (pyeclib_handle == NULL) {
+    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_get_stats");
+    return NULL;
+  }
+
+  operations = PyDict_New();
+  errors = PyDict_New();
+  if (NULL == operations || NULL == errors) {
+    goto error;
+  }
+  for (i = 0; i < PYECLIB_NUM_OPS; i++) {
+    pyeclib_op_stats_t *stats = &pyeclib_handle->stats[i];
+    uint64_t total_ns = STATS_TAKE(stats->total_ns, reset);
+    uint64_t native_ns = STATS_TAKE(stats->native_ns, reset);
+    PyObject *op_dict;
+
+    op_dict = Py_BuildValue(
+      "{s:K, s:K, s:K, s:K, s:K, s:K, s:K}",
+      "calls", (unsigned long long) STATS_TAKE(stats->calls, reset),
+      "errors", (unsigned long long) STATS_TAKE(stats->errors, reset),
+      "bytes_in", (unsigned long long) STATS_TAKE(stats->bytes_in, reset),
+      "bytes_out", (unsigned long long) STATS_TAKE(stats->bytes_out, reset),
+      "bytes_copied", (unsigned long long) STATS_TAKE(stats->bytes_copied, reset),
+      "native_ns", (unsigned long long) native_ns,
+      /* The counters are read one by one; don't let a racing call underflow */
+      "marshal_ns", (unsigned long long) (total_ns > native_ns ? total_ns - native_ns : 0));
+    if (NULL == op_dict ||
+        PyDict_SetItemString(operations, stats_op_names[i], op_dict) < 0) {
+      Py_XDECREF(op_dict);
+      goto error;
+    }
+    Py_DECREF(op_dict);
+  }
+  for (i = 0; i < PYECLIB_NUM_ERRS; i++) {
+    PyObject *count;
+
+    count = PyLong_FromUnsignedLongLong(
+      STATS_TAKE(pyeclib_handle->errors[i], reset));
+    if (NULL == count ||
+        PyDict_SetItemString(errors, stats_error_names[i], count) < 0) {
+      Py_XDECREF(count);
+      goto error;
+    }
+    Py_DECREF(count);
+  }
+
+  ret_dict = Py_BuildValue("{s:O, s:O}", "operations", operations,
+                           "errors", errors);
+  if (NULL == ret_dict) {
+    goto error;
+  }
+
+exit:
+  Py_XDECREF(operations);
+  Py_XDECREF(errors);
+  return ret_dict;
+
+error:
+  pyeclib_c_seterr(-ENOMEM, "pyeclib_c_get_stats");
+  goto exit;
+}
+
+
+/**
+ * Reconstruct a missing fragment from the the remaining fragments.
+ *
+ * TODO: If we are reconstructing a parity element, ensure that all of the
+ * data elements are available!
+ *
+ * @param pyeclib_obj_handle
+ * @param data_list k length list of data elements
+ * @param parity_list m length list of parity elements
+ * @param missing_idx_list list of the indexes of missing elements
+ * @param destination_idx index of fragment to reconstruct
+ * @param fragment_size size in bytes of the fragments
+ * @param zero_copy (optional) return a read-only memoryview of the
+ *        reconstructed fragment instead of copying it into bytes
+ * @return reconstructed destination fragment or NULL on error
+ */
+static PyObject *
+pyeclib_c_reconstruct(PyObject *self, PyObject *args)
+{
+  PyObject *pyeclib_obj_handle = NULL;
+  pyeclib_t *pyeclib_handle = NULL;
+  PyObject *fragments = NULL;           /* param, list of fragments */
+  Py_buffer *fragment_views = NULL;     /* buffers backing c_fragments */
+  PyObject *reconstructed = NULL;       /* reconstructed object to return */
+  char * c_reconstructed = NULL;        /* C string of reconstructed fragment */
   int fragment_len;                     /* param, size in bytes of fragment */
   int num_fragments;                    /* number of fragments passed in */
   char **c_fragments = NULL;            /* C array containing the fragment payloads */
   int destination_idx;                  /* param, index to reconstruct */
-  int ret;                              /* decode matrix creation return val */
-  int i = 0;                            /* a counter */
+  int zero_copy = 0;                    /* param, return a memoryview */
+  int ret = 0;                          /* decode matrix creation return val */
 
   /* Obtain and validate the method parameters */
-  if (!PyArg_ParseTuple(args, "OOii", &pyeclib_obj_handle, &fragments,
-                                        &fragment_len, &destination_idx)) {
+  if (!PyArg_ParseTuple(args, "OOii|p", &pyeclib_obj_handle, &fragments,
+                                        &fragment_len, &destination_idx,
+                                        &zero_copy)) {
     pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_reconstruct");
     return NULL;
   }
@@ -712,6 +2045,8 @@ pyeclib_c_reconstruct(PyObject *self, PyObject *args)
   }
 
   num_fragments = PyList_Size(fragments);
+  PYECLIB_PROBE(reconstruct_entry, PYECLIB_PROBE_HANDLE(pyeclib_handle),
+                num_fragments, fragment_len, destination_idx);
 
   c_fragments = (char **) alloc_zeroed_buffer(sizeof(char *) * num_fragments);
   if (NULL == c_fragments) {
@@ -720,27 +2055,47 @@ pyeclib_c_reconstruct(PyObject *self, PyObject *args)
   }
 
   c_reconstructed = (char*) alloc_zeroed_buffer(sizeof(char) * fragment_len);
-  if (NULL == c_fragments) {
+  if (NULL == c_reconstructed) {
     pyeclib_c_seterr(-ENOMEM, "pyeclib_c_reconstruct");
     goto error;
   }
 
   /* Put the fragments into an array of C strings */
-  for (i = 0; i < num_fragments; i++) {
-    PyObject *tmp_data = PyList_GetItem(fragments, i);
-    Py_ssize_t len = 0;
-    PyBytes_AsStringAndSize(tmp_data, &(c_fragments[i]), &len);
+  ret = get_fragment_buffers(fragments, num_fragments, fragment_len,
+                             PyBUF_SIMPLE, &fragment_views, c_fragments);
+  if (ret < 0) {
+    pyeclib_c_seterr(ret, "pyeclib_c_reconstruct");
+    goto error;
   }
 
+  PYECLIB_BEGIN_NATIVE
   ret = liberasurecode_reconstruct_fragment(pyeclib_handle->ec_desc,
                                             c_fragments,
                                             num_fragments,
                                             fragment_len,
                                             destination_idx,
                                             c_reconstructed);
+  PYECLIB_END_NATIVE
   if (ret < 0) {
     pyeclib_c_seterr(ret, "pyeclib_c_reconstruct");
     reconstructed = NULL;
+  } else if (zero_copy) {
+    pyeclib_native_result_t *result;
+    PyObject *owner;
+
+    result = (pyeclib_native_result_t *) alloc_zeroed_buffer(sizeof(pyeclib_native_result_t));
+    if (NULL == result) {
+      pyeclib_c_seterr(-ENOMEM, "pyeclib_c_reconstruct");
+      goto error;
+    }
+    result->reconstructed = c_reconstructed;
+    owner = native_result_new(result);
+    if (NULL != owner) {
+      reconstructed = native_memoryview(owner, c_reconstructed, fragment_len);
+      Py_DECREF(owner);
+    }
+    /* Ownership moved to the capsule, even if creating it failed */
+    c_reconstructed = NULL;
   } else {
     reconstructed = PY_BUILDVALUE_OBJ_LEN(c_reconstructed, fragment_len);
   }
@@ -751,46 +2106,531 @@ error:
   reconstructed = NULL;
 
 out:
+  release_fragment_buffers(fragment_views, num_fragments);
   check_and_free_buffer(c_fragments);
   check_and_free_buffer(c_reconstructed);
 
+  PYECLIB_PROBE(reconstruct_return, PYECLIB_PROBE_HANDLE(pyeclib_handle),
+                num_fragments, destination_idx,
+                PYECLIB_PROBE_RC(reconstructed, ret));
   return reconstructed;
 }
 
+
 /**
- * Decode a set of fragments into the original string
+ * Reconstruct a missing fragment directly into a caller-supplied buffer.
  *
  * @param pyeclib_obj_handle
- * @param data_list k length list of data elements
- * @param parity_list m length list of parity elements
- * @param missing_idx_list list of the indexes of missing elements
+ * @param fragments list of available fragments
  * @param fragment_size size in bytes of the fragments
- * @return list of fragments
+ * @param destination_idx index of fragment to reconstruct
+ * @param output writable buffer of at least fragment_size bytes
+ * @return python int, the number of bytes written to output
  */
 static PyObject *
-pyeclib_c_decode(PyObject *self, PyObject *args)
+pyeclib_c_reconstruct_into(PyObject *self, PyObject *args)
 {
   PyObject *pyeclib_obj_handle = NULL;
   pyeclib_t *pyeclib_handle = NULL;
-  PyObject *fragments = NULL;             /* param, list of missing indexes */
+  PyObject *fragments = NULL;           /* param, list of fragments */
+  Py_buffer *fragment_views = NULL;     /* buffers backing c_fragments */
+  Py_buffer output;                     /* param, buffer to reconstruct into */
+  PyObject *ret_obj = NULL;             /* python int to return */
+  int fragment_len;                     /* param, size in bytes of fragment */
+  int num_fragments = 0;                /* number of fragments passed in */
+  char **c_fragments = NULL;            /* C array containing the fragment payloads */
+  int destination_idx;                  /* param, index to reconstruct */
+  int ret;
+
+  if (!PyArg_ParseTuple(args, "OOiiw*", &pyeclib_obj_handle, &fragments,
+                        &fragment_len, &destination_idx, &output)) {
+    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_reconstruct_into");
+    return NULL;
+  }
+  pyeclib_handle = (pyeclib_t*)PyCapsule_GetPointer(pyeclib_obj_handle, PYECC_HANDLE_NAME);
+  if (pyeclib_handle == NULL || !PyList_Check(fragments) ||
+      fragment_len <= 0 || output.len < fragment_len) {
+    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_reconstruct_into");
+    goto exit;
+  }
+
+  num_fragments = PyList_Size(fragments);
+  c_fragments = (char **) alloc_zeroed_buffer(sizeof(char *) * num_fragments);
+  if (NULL == c_fragments) {
+    pyeclib_c_seterr(-ENOMEM, "pyeclib_c_reconstruct_into");
+    goto exit;
+  }
+  ret = get_fragment_buffers(fragments, num_fragments, fragment_len,
+                             PyBUF_SIMPLE, &fragment_views, c_fragments);
+  if (ret < 0) {
+    pyeclib_c_seterr(ret, "pyeclib_c_reconstruct_into");
+    goto exit;
+  }
+
+  /* liberasurecode writes the fragment straight into the caller's buffer */
+  PYECLIB_BEGIN_NATIVE
+  ret = liberasurecode_reconstruct_fragment(pyeclib_handle->ec_desc,
+                                            c_fragments,
+                                            num_fragments,
+                                            fragment_len,
+                                            destination_idx,
+                                            output.buf);
+  PYECLIB_END_NATIVE
+  if (ret < 0) {
+    pyeclib_c_seterr(ret, "pyeclib_c_reconstruct_into");
+    goto exit;
+  }
+  stats_count_out(fragment_len, 0);
+  ret_obj = PyLong_FromLong(fragment_len);
+
+exit:
+  release_fragment_buffers(fragment_views, num_fragments);
+  check_and_free_buffer(c_fragments);
+  PyBuffer_Release(&output);
+  return ret_obj;
+}
+
+
+/**
+ * Reconstruct several missing fragments in one call.
+ *
+ * The survivors are marshalled once and every index is rebuilt with the
+ * GIL released.  Indexes are processed in the order given, and each rebuilt
+ * fragment is made available to the ones after it, so callers should pass
+ * data indexes before parity indexes (i.e. sorted).
+ *
+ * @param pyeclib_obj_handle
+ * @param fragments list of available fragments
+ * @param fragment_size size in bytes of the fragments
+ * @param destination_idxs list of indexes to reconstruct
+ * @param zero_copy (optional) return read-only memoryviews instead of bytes
+ * @return list of reconstructed fragments, one per index
+ */
+static PyObject *
+pyeclib_c_reconstruct_many(PyObject *self, PyObject *args)
+{
+  PyObject *pyeclib_obj_handle = NULL;
+  pyeclib_t *pyeclib_handle = NULL;
+  PyObject *fragments = NULL;           /* param, list of fragments */
+  PyObject *destination_list = NULL;    /* param, list of indexes */
+  Py_buffer *fragment_views = NULL;     /* buffers backing c_fragments */
+  PyObject *reconstructed = NULL;       /* list to return */
+  PyObject *owner = NULL;               /* keeps zero-copy results alive */
+  char *c_reconstructed = NULL;         /* all rebuilt fragments, back to back */
+  char **c_fragments = NULL;            /* survivors, then rebuilt fragments */
+  int *c_destinations = NULL;           /* C array of indexes to rebuild */
+  int fragment_len;                     /* param, size in bytes of fragment */
+  int num_fragments = 0;                /* number of fragments passed in */
+  int num_destinations = 0;             /* number of indexes to rebuild */
+  int zero_copy = 0;                    /* param, return memoryviews */
+  int i;
+  int ret = 0;
+
+  if (!PyArg_ParseTuple(args, "OOiO|p", &pyeclib_obj_handle, &fragments,
+                        &fragment_len, &destination_list, &zero_copy)) {
+    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_reconstruct_many");
+    return NULL;
+  }
+  pyeclib_handle = (pyeclib_t*)PyCapsule_GetPointer(pyeclib_obj_handle, PYECC_HANDLE_NAME);
+  if (pyeclib_handle == NULL || !PyList_Check(fragments) ||
+      !PyList_Check(destination_list) || fragment_len <= 0) {
+    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_reconstruct_many");
+    return NULL;
+  }
+
+  num_fragments = PyList_Size(fragments);
+  num_destinations = PyList_Size(destination_list);
+  if (num_destinations == 0) {
+    return PyList_New(0);
+  }
+
+  c_destinations = (int *) alloc_zeroed_buffer(sizeof(int) * num_destinations);
+  c_fragments = (char **) alloc_zeroed_buffer(sizeof(char *) * (num_fragments + num_destinations));
+  c_reconstructed = (char *) alloc_zeroed_buffer((size_t) fragment_len * num_destinations);
+  if (NULL == c_destinations || NULL == c_fragments || NULL == c_reconstructed) {
+    pyeclib_c_seterr(-ENOMEM, "pyeclib_c_reconstruct_many");
+    goto exit;
+  }
+  for (i = 0; i < num_destinations; i++) {
+    c_destinations[i] = (int) PyLong_AsLong(PyList_GetItem(destination_list, i));
+    if (PyErr_Occurred()) {
+      pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_reconstruct_many");
+      goto exit;
+    }
+  }
+
+  ret = get_fragment_buffers(fragments, num_fragments, fragment_len,
+                             PyBUF_SIMPLE, &fragment_views, c_fragments);
+  if (ret < 0) {
+    pyeclib_c_seterr(ret, "pyeclib_c_reconstruct_many");
+    goto exit;
+  }
+
+  PYECLIB_BEGIN_NATIVE
+  for (i = 0; i < num_destinations; i++) {
+    char *out = c_reconstructed + (size_t) fragment_len * i;
+
+    ret = liberasurecode_reconstruct_fragment(pyeclib_handle->ec_desc,
+                                              c_fragments,
+                                              num_fragments + i,
+                                              fragment_len,
+                                              c_destinations[i],
+                                              out);
+    if (ret < 0) {
+      break;
+    }
+    /* Later (parity) indexes may need this fragment */
+    c_fragments[num_fragments + i] = out;
+  }
+  PYECLIB_END_NATIVE
+  if (ret < 0) {
+    pyeclib_c_seterr(ret, "pyeclib_c_reconstruct_many");
+    goto exit;
+  }
+
+  if (zero_copy) {
+    pyeclib_native_result_t *result;
+
+    result = (pyeclib_native_result_t *) alloc_zeroed_buffer(sizeof(pyeclib_native_result_t));
+    if (NULL == result) {
+      pyeclib_c_seterr(-ENOMEM, "pyeclib_c_reconstruct_many");
+      goto exit;
+    }
+    result->reconstructed = c_reconstructed;
+    owner = native_result_new(result);
+    if (NULL == owner) {
+      c_reconstructed = NULL;
+      goto exit;
+    }
+  }
+
+  reconstructed = PyList_New(num_destinations);
+  if (NULL == reconstructed) {
+    pyeclib_c_seterr(-ENOMEM, "pyeclib_c_reconstruct_many");
+    goto exit;
+  }
+  for (i = 0; i < num_destinations; i++) {
+    char *out = c_reconstructed + (size_t) fragment_len * i;
+    PyObject *item;
+
+    if (NULL != owner) {
+      item = native_memoryview(owner, out, fragment_len);
+    } else {
+      item = PY_BUILDVALUE_OBJ_LEN(out, fragment_len);
+    }
+    if (NULL == item) {
+      Py_CLEAR(reconstructed);
+      goto exit;
+    }
+    PyList_SetItem(reconstructed, i, item);
+  }
+
+exit:
+  if (NULL != owner) {
+    /* The capsule owns c_reconstructed now */
+    Py_DECREF(owner);
+  } else {
+    check_and_free_buffer(c_reconstructed);
+  }
+  release_fragment_buffers(fragment_views, num_fragments);
+  check_and_free_buffer(c_fragments);
+  check_and_free_buffer(c_destinations);
+  return reconstructed;
+}
+
+/**
+ * Whether a backend stores the payload unmodified in its data fragments, so
+ * that fragment i holds bytes [i * size, (i + 1) * size) of the original.
+ * shss and libphazr transform the data and are left to liberasurecode.
+ */
+static int
+is_systematic_backend(ec_backend_id_t backend_id)
+{
+  switch (backend_id) {
+    case EC_BACKEND_JERASURE_RS_VAND:
+    case EC_BACKEND_JERASURE_RS_CAUCHY:
+    case EC_BACKEND_FLAT_XOR_HD:
+    case EC_BACKEND_ISA_L_RS_VAND:
+    case EC_BACKEND_LIBERASURECODE_RS_VAND:
+    case EC_BACKEND_ISA_L_RS_CAUCHY:
+#if defined(LIBERASURECODE_VERSION) && LIBERASURECODE_VERSION >= 0x010701
+    case EC_BACKEND_ISA_L_RS_VAND_INV:
+#endif
+#if defined(LIBERASURECODE_VERSION) && LIBERASURECODE_VERSION >= 0x010800
+    case EC_BACKEND_ISA_L_RS_LRC:
+#endif
+      return 1;
+    default:
+      /* Including backends newer than this build knows about */
+      return 0;
+  }
+}
+
+/**
+ * Locate the payload bytes held by each data fragment of a stripe.
+ *
+ * Every header is validated by liberasurecode_get_fragment_metadata(), so a
+ * header liberasurecode_decode() would reject is never trusted here.  Only a
+ * consistent stripe from a systematic backend qualifies; anything else (bad
+ * header checksum, mixed sizes, ...) is left for liberasurecode_decode() to
+ * handle and report.
+ *
+ * May be called without the GIL.
+ *
+ * @param fragments available fragments
+ * @param num_fragments number of available fragments
+ * @param fragment_len size in bytes of each fragment, header included
+ * @param k number of data fragments
+ * @param columns k length array, set to the payload of data fragment i or
+ *        NULL if it is not among the available fragments
+ * @param block_size set to the number of payload bytes per fragment
+ * @param orig_data_size set to the size of the original payload
+ * @return 0 if the stripe can be read directly, 1 otherwise
+ */
+static int
+get_systematic_layout(char **fragments, int num_fragments, int fragment_len,
+                      int k, char **columns, uint32_t *block_size,
+                      uint64_t *orig_data_size)
+{
+  fragment_metadata_t first;
+  fragment_metadata_t meta;
+  int i;
+
+  if (num_fragments < 1 || fragment_len < (int) sizeof(fragment_header_t)) {
+    return 1;
+  }
+
+  memset(columns, 0, k * sizeof(char *));
+  for (i = 0; i < num_fragments; i++) {
+    fragment_header_t *header = (fragment_header_t *) fragments[i];
+
+    /*
+     * An inline checksum is computed over meta.size bytes, so don't let an
+     * unchecked size send liberasurecode past the end of the fragment.
+     */
+    if (header->meta.size > fragment_len - sizeof(fragment_header_t) ||
+        liberasurecode_get_fragment_metadata(fragments[i], &meta) < 0) {
+      return 1;
+    }
+    if (i == 0) {
+      first = meta;
+    } else if (meta.size != first.size ||
+               meta.orig_data_size != first.orig_data_size ||
+               meta.backend_id != first.backend_id) {
+      return 1;
+    }
+    if (meta.idx < (uint32_t) k && NULL == columns[meta.idx]) {
+      columns[meta.idx] = fragments[i] + sizeof(fragment_header_t);
+    }
+  }
+
+  if (!is_systematic_backend(first.backend_id) ||
+      (uint64_t) first.size * k < first.orig_data_size) {
+    return 1;
+  }
+
+  *block_size = first.size;
+  *orig_data_size = first.orig_data_size;
+  return 0;
+}
+
+/**
+ * Copy a byte range of the original payload out of the data fragments.
+ */
+static void
+copy_systematic_range(char **columns, uint32_t block_size,
+                      uint64_t offset, uint64_t length, char *dest)
+{
+  while (length > 0) {
+    uint64_t column = offset / block_size;
+    uint64_t within = offset % block_size;
+    uint64_t chunk = block_size - within;
+
+    if (chunk > length) {
+      chunk = length;
+    }
+    memcpy(dest, columns[column] + within, chunk);
+    dest += chunk;
+    offset += chunk;
+    length -= chunk;
+  }
+}
+
+/**
+ * Decode byte ranges of a payload without decoding the whole payload.
+ *
+ * Ranges are mapped onto the data fragments that cover them and copied
+ * straight out of those.  Data fragments that a range needs but that are
+ * missing are rebuilt one at a time with liberasurecode_reconstruct_fragment(),
+ * so only the affected columns pay for decoding.
+ *
+ * @param pyeclib_handle
+ * @param fragments available fragments
+ * @param num_fragments number of available fragments
+ * @param fragment_len size in bytes of each fragment
+ * @param ranges byte ranges to extract
+ * @param num_ranges number of byte ranges
+ * @param zero_copy return read-only memoryviews rather than bytes
+ * @param orig_data_size set to the size of the original payload on success
+ * @return python list with one object per range; NULL with an exception set
+ *         on error, or NULL without one if the caller should fall back to a
+ *         full decode
+ */
+static PyObject *
+decode_systematic_ranges(pyeclib_t *pyeclib_handle, char **fragments,
+                         int num_fragments, int fragment_len,
+                         pyeclib_byte_range_t *ranges, int num_ranges,
+                         int zero_copy, uint64_t *orig_data_size)
+{
+  int k = pyeclib_handle->ec_args.k;
+  char **columns = NULL;            /* payload of each data fragment */
+  char *wanted = NULL;              /* per column, already in missing */
+  int *missing = NULL;              /* data fragments to rebuild */
+  int num_missing = 0;
+  char *rebuilt = NULL;             /* one fragment_len slot per rebuild */
+  uint32_t block_size;
+  uint64_t payload_size;
+  PyObject *ret_list = NULL;
+  int i, ret = 0;
+
+  columns = (char **) alloc_zeroed_buffer(k * sizeof(char *));
+  wanted = (char *) alloc_zeroed_buffer(k);
+  missing = (int *) alloc_zeroed_buffer(k * sizeof(int));
+  if (NULL == columns || NULL == wanted || NULL == missing) {
+    pyeclib_c_seterr(-ENOMEM, "pyeclib_c_decode");
+    goto exit;
+  }
+  /* Validating the headers may checksum every payload */
+  PYECLIB_BEGIN_NATIVE
+  ret = get_systematic_layout(fragments, num_fragments, fragment_len, k,
+                              columns, &block_size, &payload_size);
+  PYECLIB_END_NATIVE
+  if (ret != 0) {
+    goto exit;
+  }
+
+  for (i = 0; i < num_ranges; i++) {
+    uint64_t column, last;
+
+    if (ranges[i].offset > payload_size ||
+        ranges[i].length > payload_size - ranges[i].offset) {
+      pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_decode invalid range");
+      goto exit;
+    }
+    if (ranges[i].length == 0) {
+      continue;
+    }
+    last = (ranges[i].offset + ranges[i].length - 1) / block_size;
+    for (column = ranges[i].offset / block_size; column <= last; column++) {
+      if (NULL == columns[column] && !wanted[column]) {
+        wanted[column] = 1;
+        missing[num_missing++] = (int) column;
+      }
+    }
+  }
+
+  if (num_missing > 0) {
+    /* num_missing <= k, but k * fragment_len may still not fit in an int */
+    if ((size_t) num_missing > SIZE_MAX / (size_t) fragment_len) {
+      pyeclib_c_seterr(-ENOMEM, "pyeclib_c_decode");
+      goto exit;
+    }
+    rebuilt = (char *) calloc((size_t) num_missing, (size_t) fragment_len);
+    if (NULL == rebuilt) {
+      pyeclib_c_seterr(-ENOMEM, "pyeclib_c_decode");
+      goto exit;
+    }
+    PYECLIB_BEGIN_NATIVE
+    for (i = 0; i < num_missing && ret == 0; i++) {
+      ret = liberasurecode_reconstruct_fragment(pyeclib_handle->ec_desc,
+                                                fragments, num_fragments,
+                                                fragment_len, missing[i],
+                                                rebuilt + (size_t) i * fragment_len);
+    }
+    PYECLIB_END_NATIVE
+    if (ret < 0) {
+      /* Let the full decode report whatever is wrong with the stripe */
+      goto exit;
+    }
+    for (i = 0; i < num_missing; i++) {
+      columns[missing[i]] = rebuilt + (size_t) i * fragment_len + sizeof(fragment_header_t);
+    }
+  }
+
+  ret_list = PyList_New(num_ranges);
+  if (NULL == ret_list) {
+    pyeclib_c_seterr(-ENOMEM, "pyeclib_c_decode");
+    goto exit;
+  }
+  for (i = 0; i < num_ranges; i++) {
+    PyObject *range_obj;
+
+    range_obj = PyBytes_FromStringAndSize(NULL, ranges[i].length);
+    if (NULL == range_obj) {
+      Py_CLEAR(ret_list);
+      goto exit;
+    }
+    copy_systematic_range(columns, block_size, ranges[i].offset,
+                          ranges[i].length, PyBytes_AS_STRING(range_obj));
+    if (zero_copy) {
+      Py_SETREF(range_obj, PyMemoryView_FromObject(range_obj));
+      if (NULL == range_obj) {
+        Py_CLEAR(ret_list);
+        goto exit;
+      }
+    }
+    PyList_SET_ITEM(ret_list, i, range_obj);
+  }
+  *orig_data_size = payload_size;
+
+exit:
+  check_and_free_buffer(columns);
+  check_and_free_buffer(wanted);
+  check_and_free_buffer(missing);
+  check_and_free_buffer(rebuilt);
+  return ret_list;
+}
+
+/**
+ * Decode a set of fragments into the original string
+ *
+ * @param pyeclib_obj_handle
+ * @param data_list k length list of data elements
+ * @param parity_list m length list of parity elements
+ * @param missing_idx_list list of the indexes of missing elements
+ * @param fragment_size size in bytes of the fragments
+ * @param zero_copy (optional) return read-only memoryviews of the buffer
+ *        allocated by liberasurecode instead of copying it into bytes
+ * @return list of fragments
+ */
+static PyObject *
+pyeclib_c_decode(PyObject *self, PyObject *args)
+{
+  PyObject *pyeclib_obj_handle = NULL;
+  pyeclib_t *pyeclib_handle = NULL;
+  PyObject *fragments = NULL;             /* param, list of missing indexes */
+  Py_buffer *fragment_views = NULL;       /* buffers backing c_fragments */
   PyObject *ret_payload = NULL;           /* object to store original payload or ranges of payload */
   PyObject *ranges = NULL;                /* a list of tuples that represent byte ranges */
   PyObject *metadata_checks_obj = NULL;   /* boolean specifying if headers should be validated before decode */
+  PyObject *owner = NULL;                 /* keeps a zero-copy payload alive */
   pyeclib_byte_range_t *c_ranges = NULL;  /* the byte ranges */
   int num_ranges = 0;                     /* number of specified ranges */
   int fragment_len;                       /* param, size in bytes of fragment */
   char **c_fragments = NULL;              /* k length array of data buffers */
   int num_fragments;                      /* param, number of fragments */
   char *c_orig_payload = NULL;            /* buffer to store original payload in */
+  char *payload = NULL;                   /* decoded payload, owned or not */
   uint64_t range_payload_size = 0;        /* length of buffer used to store byte ranges */
   uint64_t orig_data_size = 0;            /* data size in bytes ,from fragment hdr */
   int i = 0;                              /* counters */
   int force_metadata_checks = 0;          /* validate the fragment headers before decoding */
+  int zero_copy = 0;                      /* param, return memoryviews */
   int ret = 0;
 
   /* Obtain and validate the method parameters */
-  if (!PyArg_ParseTuple(args, "OOi|OO",&pyeclib_obj_handle, &fragments,
-    &fragment_len, &ranges, &metadata_checks_obj)) {
+  if (!PyArg_ParseTuple(args, "OOi|OOp",&pyeclib_obj_handle, &fragments,
+    &fragment_len, &ranges, &metadata_checks_obj, &zero_copy)) {
     pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_decode");
     return NULL;
   }
@@ -820,9 +2660,13 @@ pyeclib_c_decode(PyObject *self, PyObject *args)
   if (ranges) {
     num_ranges = PyList_Size(ranges);
   }
+  PYECLIB_PROBE(decode_entry, PYECLIB_PROBE_HANDLE(pyeclib_handle),
+                num_fragments, fragment_len, num_ranges);
 
   if (pyeclib_handle->ec_args.k > num_fragments) {
     pyeclib_c_seterr(-EINSUFFFRAGS, "pyeclib_c_decode");
+    PYECLIB_PROBE(decode_return, PYECLIB_PROBE_HANDLE(pyeclib_handle),
+                  num_fragments, orig_data_size, -EINSUFFFRAGS);
     return NULL;
   }
 
@@ -865,16 +2709,33 @@ pyeclib_c_decode(PyObject *self, PyObject *args)
 
   c_fragments = (char **) alloc_zeroed_buffer(sizeof(char *) * num_fragments);
   if (NULL == c_fragments) {
+    pyeclib_c_seterr(-ENOMEM, "pyeclib_c_decode");
     goto error;
   }
 
   /* Put the fragments into an array of C strings */
-  for (i = 0; i < num_fragments; i++) {
-    PyObject *tmp_data = PyList_GetItem(fragments, i);
-    Py_ssize_t len = 0;
-    PyBytes_AsStringAndSize(tmp_data, &(c_fragments[i]), &len);
+  ret = get_fragment_buffers(fragments, num_fragments, fragment_len,
+                             PyBUF_SIMPLE, &fragment_views, c_fragments);
+  if (ret < 0) {
+    pyeclib_c_seterr(ret, "pyeclib_c_decode");
+    goto error;
   }
 
+  /* Small ranges should not pay for decoding the whole payload */
+  if (num_ranges > 0 && !force_metadata_checks) {
+    ret_payload = decode_systematic_ranges(pyeclib_handle, c_fragments,
+                                           num_fragments, fragment_len,
+                                           c_ranges, num_ranges, zero_copy,
+                                           &orig_data_size);
+    if (NULL != ret_payload) {
+      goto exit;
+    }
+    if (PyErr_Occurred()) {
+      goto error;
+    }
+  }
+
+  PYECLIB_BEGIN_NATIVE
   ret = liberasurecode_decode(pyeclib_handle->ec_desc,
                             c_fragments,
                             num_fragments,
@@ -882,14 +2743,38 @@ pyeclib_c_decode(PyObject *self, PyObject *args)
                             force_metadata_checks,
                             &c_orig_payload,
                             &orig_data_size);
+  PYECLIB_END_NATIVE
 
   if (ret < 0) {
     pyeclib_c_seterr(ret, "pyeclib_c_decode");
     goto error;
   }
 
+  payload = c_orig_payload;
+  if (zero_copy) {
+    pyeclib_native_result_t *result;
+
+    result = (pyeclib_native_result_t *) alloc_zeroed_buffer(sizeof(pyeclib_native_result_t));
+    if (NULL == result) {
+      pyeclib_c_seterr(-ENOMEM, "pyeclib_c_decode");
+      goto error;
+    }
+    native_result_pin(result, pyeclib_obj_handle, pyeclib_handle);
+    result->decoded = c_orig_payload;
+    /* Ownership moved to the capsule, even if creating it failed */
+    c_orig_payload = NULL;
+    owner = native_result_new(result);
+    if (NULL == owner) {
+      goto error;
+    }
+  }
+
   if (num_ranges == 0) {
-    ret_payload = PY_BUILDVALUE_OBJ_LEN(c_orig_payload, orig_data_size);
+    if (NULL != owner) {
+      ret_payload = native_memoryview(owner, payload, orig_data_size);
+    } else {
+      ret_payload = PY_BUILDVALUE_OBJ_LEN(payload, orig_data_size);
+    }
   } else {
     ret_payload = PyList_New(num_ranges);
     if (NULL == ret_payload) {
@@ -903,48 +2788,319 @@ pyeclib_c_decode(PyObject *self, PyObject *args)
         pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_decode invalid range");
         goto error;
       }
-      PyList_SetItem(ret_payload, i,
-        PY_BUILDVALUE_OBJ_LEN(c_orig_payload + c_ranges[i].offset, c_ranges[i].length));
+      if (NULL != owner) {
+        PyList_SetItem(ret_payload, i,
+          native_memoryview(owner, payload + c_ranges[i].offset, c_ranges[i].length));
+      } else {
+        PyList_SetItem(ret_payload, i,
+          PY_BUILDVALUE_OBJ_LEN(payload + c_ranges[i].offset, c_ranges[i].length));
+      }
     }
   }
 
   goto exit;
 
 error:
-  ret_payload = NULL;
+  Py_CLEAR(ret_payload);
 
 exit:
+  release_fragment_buffers(fragment_views, num_fragments);
   check_and_free_buffer(c_fragments);
   check_and_free_buffer(c_ranges);
+  Py_XDECREF(owner);
   liberasurecode_decode_cleanup(pyeclib_handle->ec_desc, c_orig_payload);
 
+  PYECLIB_PROBE(decode_return, PYECLIB_PROBE_HANDLE(pyeclib_handle),
+                num_fragments, orig_data_size,
+                PYECLIB_PROBE_RC(ret_payload, ret));
   return ret_payload;
 }
 
 
-static const char* chksum_type_to_str(uint8_t chksum_type)
+/**
+ * Decode a set of fragments into a caller-supplied buffer
+ *
+ * @param pyeclib_obj_handle
+ * @param fragments list of available fragments
+ * @param fragment_size size in bytes of the fragments
+ * @param output writable buffer at least as large as the original payload
+ * @param force_metadata_checks validate the fragment headers before decoding
+ * @return python int, the number of bytes written to output
+ */
+static PyObject *
+pyeclib_c_decode_into(PyObject *self, PyObject *args)
 {
-  const char *chksum_type_str = NULL;
-  switch (chksum_type)
-  {
-    case CHKSUM_NONE:
-      chksum_type_str = "none\0";
-      break;
-    case CHKSUM_CRC32:
-      chksum_type_str = "crc32\0";
-      break;
-    case CHKSUM_MD5:
-      chksum_type_str = "md5\0";
-      break;
-    default:
-      chksum_type_str = "unknown\0";
+  PyObject *pyeclib_obj_handle = NULL;
+  pyeclib_t *pyeclib_handle = NULL;
+  PyObject *fragments = NULL;             /* param, list of fragments */
+  Py_buffer *fragment_views = NULL;       /* buffers backing c_fragments */
+  Py_buffer output;                       /* param, buffer to decode into */
+  PyObject *metadata_checks_obj = NULL;   /* validate headers before decode */
+  PyObject *ret_obj = NULL;               /* python int to return */
+  int fragment_len;                       /* param, size in bytes of fragment */
+  char **c_fragments = NULL;              /* array of fragment buffers */
+  int num_fragments = 0;                  /* number of fragments */
+  char *c_orig_payload = NULL;            /* buffer liberasurecode decodes into */
+  uint64_t orig_data_size = 0;            /* data size in bytes, from fragment hdr */
+  int force_metadata_checks = 0;
+  int ret = 0;
+
+  if (!PyArg_ParseTuple(args, "OOiw*|O", &pyeclib_obj_handle, &fragments,
+                        &fragment_len, &output, &metadata_checks_obj)) {
+    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_decode_into");
+    return NULL;
+  }
+  if (NULL != metadata_checks_obj && PyObject_IsTrue(metadata_checks_obj)) {
+    force_metadata_checks = 1;
+  }
+  pyeclib_handle = (pyeclib_t*)PyCapsule_GetPointer(pyeclib_obj_handle, PYECC_HANDLE_NAME);
+  if (pyeclib_handle == NULL || !PyList_Check(fragments)) {
+    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_decode_into");
+    goto exit;
   }
 
-  return chksum_type_str;
-}
+  num_fragments = PyList_Size(fragments);
+  if (pyeclib_handle->ec_args.k > num_fragments) {
+    pyeclib_c_seterr(-EINSUFFFRAGS, "pyeclib_c_decode_into");
+    goto exit;
+  }
+  c_fragments = (char **) alloc_zeroed_buffer(sizeof(char *) * num_fragments);
+  if (NULL == c_fragments) {
+    pyeclib_c_seterr(-ENOMEM, "pyeclib_c_decode_into");
+    goto exit;
+  }
+  ret = get_fragment_buffers(fragments, num_fragments, fragment_len,
+                             PyBUF_SIMPLE, &fragment_views, c_fragments);
+  if (ret < 0) {
+    pyeclib_c_seterr(ret, "pyeclib_c_decode_into");
+    goto exit;
+  }
 
-static int chksum_length(uint8_t chksum_type)
-{
+  PYECLIB_BEGIN_NATIVE
+  ret = liberasurecode_decode(pyeclib_handle->ec_desc,
+                              c_fragments,
+                              num_fragments,
+                              fragment_len,
+                              force_metadata_checks,
+                              &c_orig_payload,
+                              &orig_data_size);
+  if (ret == 0) {
+    if (orig_data_size > (uint64_t) output.len) {
+      ret = -EINVALIDPARAMS;
+    } else {
+      memcpy(output.buf, c_orig_payload, orig_data_size);
+    }
+  }
+  PYECLIB_END_NATIVE
+
+  if (ret < 0) {
+    pyeclib_c_seterr(ret, "pyeclib_c_decode_into");
+    goto exit;
+  }
+  stats_count_out(orig_data_size, 0);
+  ret_obj = PyLong_FromUnsignedLongLong(orig_data_size);
+
+exit:
+  if (NULL != c_orig_payload) {
+    liberasurecode_decode_cleanup(pyeclib_handle->ec_desc, c_orig_payload);
+  }
+  release_fragment_buffers(fragment_views, num_fragments);
+  check_and_free_buffer(c_fragments);
+  PyBuffer_Release(&output);
+  return ret_obj;
+}
+
+
+/**
+ * Per-item state for pyeclib_c_decode_many()
+ */
+typedef struct pyeclib_decode_item_s {
+  Py_buffer *views;                 /* buffers backing fragments */
+  char **fragments;                 /* C array of fragment payloads */
+  int num_fragments;
+  int fragment_len;
+  int ret;                          /* validation or decode return value */
+  char *payload;                    /* decoded data, from liberasurecode */
+  uint64_t payload_len;
+} pyeclib_decode_item_t;
+
+/**
+ * Decode a batch of fragment sets in a single call.
+ *
+ * The fragment size of each set is taken from its fragments, which must all
+ * be the same length.  Sets are decoded with the GIL released, in chunks of
+ * BATCH_CHUNK_BYTES of fragments like encode_many().  An error decoding one
+ * set is returned in place of its payload and does not affect the others.
+ *
+ * @param pyeclib_obj_handle
+ * @param fragment_sets list of lists of fragments
+ * @param force_metadata_checks (optional) validate the fragment headers
+ *        before decoding
+ * @return python list with, per set, either the original data or the
+ *         pyeclib exception describing why decoding it failed
+ */
+static PyObject *
+pyeclib_c_decode_many(PyObject *self, PyObject *args)
+{
+  PyObject *pyeclib_obj_handle = NULL;
+  pyeclib_t *pyeclib_handle = NULL;
+  PyObject *fragment_sets = NULL;         /* param, list of fragment lists */
+  PyObject *metadata_checks_obj = NULL;   /* validate headers before decode */
+  pyeclib_decode_item_t *items = NULL;    /* per set state */
+  PyObject *results = NULL;               /* python list to return */
+  int force_metadata_checks = 0;
+  int num_items = 0;
+  int start, end;                         /* chunk of sets being decoded */
+  int i, j;
+
+  if (!PyArg_ParseTuple(args, "OO|O", &pyeclib_obj_handle, &fragment_sets,
+                        &metadata_checks_obj)) {
+    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_decode_many");
+    return NULL;
+  }
+  if (NULL != metadata_checks_obj && PyObject_IsTrue(metadata_checks_obj)) {
+    force_metadata_checks = 1;
+  }
+  pyeclib_handle = (pyeclib_t*)PyCapsule_GetPointer(pyeclib_obj_handle, PYECC_HANDLE_NAME);
+  if (pyeclib_handle == NULL || !PyList_Check(fragment_sets)) {
+    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_decode_many");
+    return NULL;
+  }
+  num_items = PyList_Size(fragment_sets);
+  if (num_items == 0) {
+    return PyList_New(0);
+  }
+
+  items = (pyeclib_decode_item_t *) alloc_zeroed_buffer(sizeof(pyeclib_decode_item_t) * num_items);
+  if (NULL == items) {
+    pyeclib_c_seterr(-ENOMEM, "pyeclib_c_decode_many");
+    return NULL;
+  }
+
+  /* Validate every set and pin its buffers while we still hold the GIL */
+  for (i = 0; i < num_items; i++) {
+    pyeclib_decode_item_t *item = &items[i];
+    PyObject *fragments = PyList_GetItem(fragment_sets, i);
+
+    if (!PyList_Check(fragments)) {
+      item->ret = -EINVALIDPARAMS;
+      continue;
+    }
+    item->num_fragments = PyList_Size(fragments);
+    if (item->num_fragments < pyeclib_handle->ec_args.k) {
+      item->ret = -EINSUFFFRAGS;
+      continue;
+    }
+    item->fragments = (char **) alloc_zeroed_buffer(sizeof(char *) * item->num_fragments);
+    if (NULL == item->fragments) {
+      pyeclib_c_seterr(-ENOMEM, "pyeclib_c_decode_many");
+      goto exit;
+    }
+    item->ret = get_fragment_buffers(fragments, item->num_fragments, 1,
+                                     PyBUF_SIMPLE, &item->views,
+                                     item->fragments);
+    if (item->ret < 0) {
+      /* Reported per item, don't leave a stray TypeError behind */
+      PyErr_Clear();
+      continue;
+    }
+    item->fragment_len = (int) item->views[0].len;
+    for (j = 1; j < item->num_fragments; j++) {
+      if (item->views[j].len != item->views[0].len) {
+        item->ret = -EINVALIDPARAMS;
+        break;
+      }
+    }
+    if (item->views[0].len > INT_MAX) {
+      item->ret = -EINVALIDPARAMS;
+    }
+  }
+
+  results = PyList_New(num_items);
+  if (NULL == results) {
+    pyeclib_c_seterr(-ENOMEM, "pyeclib_c_decode_many");
+    goto exit;
+  }
+
+  for (start = 0; start < num_items; start = end) {
+    uint64_t chunk_bytes = 0;
+
+    end = start;
+    PYECLIB_BEGIN_NATIVE
+    do {
+      pyeclib_decode_item_t *item = &items[end];
+
+      if (item->ret == 0) {
+        item->ret = liberasurecode_decode(pyeclib_handle->ec_desc,
+                                          item->fragments,
+                                          item->num_fragments,
+                                          item->fragment_len,
+                                          force_metadata_checks,
+                                          &item->payload,
+                                          &item->payload_len);
+        chunk_bytes += (uint64_t) item->num_fragments * item->fragment_len;
+      }
+      end++;
+    } while (end < num_items && chunk_bytes < BATCH_CHUNK_BYTES);
+    PYECLIB_END_NATIVE
+
+    for (i = start; i < end; i++) {
+      PyObject *result;
+
+      if (items[i].ret < 0) {
+        stats_count_item_error(items[i].ret);
+        result = pyeclib_c_error(items[i].ret, "pyeclib_c_decode_many");
+      } else {
+        result = PY_BUILDVALUE_OBJ_LEN(items[i].payload, items[i].payload_len);
+      }
+      if (NULL != items[i].payload) {
+        liberasurecode_decode_cleanup(pyeclib_handle->ec_desc, items[i].payload);
+        items[i].payload = NULL;
+      }
+      if (NULL == result) {
+        Py_CLEAR(results);
+        goto exit;
+      }
+      PyList_SetItem(results, i, result);
+    }
+  }
+
+exit:
+  for (i = 0; i < num_items; i++) {
+    if (NULL != items[i].payload) {
+      liberasurecode_decode_cleanup(pyeclib_handle->ec_desc, items[i].payload);
+    }
+    release_fragment_buffers(items[i].views, items[i].num_fragments);
+    check_and_free_buffer(items[i].fragments);
+  }
+  free(items);
+  return results;
+}
+
+
+static const char* chksum_type_to_str(uint8_t chksum_type)
+{
+  const char *chksum_type_str = NULL;
+  switch (chksum_type)
+  {
+    case CHKSUM_NONE:
+      chksum_type_str = "none\0";
+      break;
+    case CHKSUM_CRC32:
+      chksum_type_str = "crc32\0";
+      break;
+    case CHKSUM_MD5:
+      chksum_type_str = "md5\0";
+      break;
+    default:
+      chksum_type_str = "unknown\0";
+  }
+
+  return chksum_type_str;
+}
+
+static int chksum_length(uint8_t chksum_type)
+{
   int length = 0;
   switch (chksum_type)
   {
@@ -1064,135 +3220,994 @@ pyeclib_c_get_metadata(PyObject *self, PyObject *args)
 {
   PyObject *pyeclib_obj_handle = NULL;
   pyeclib_t* pyeclib_handle = NULL;
-  char *fragment = NULL;                            /* param, fragment from caller */
+  Py_buffer fragment;                               /* param, fragment from caller */
   fragment_metadata_t c_fragment_metadata;          /* structure to hold metadata */
   PyObject *fragment_metadata = NULL;               /* metadata object to return */
-  Py_ssize_t fragment_len;                          /* fragment length */
   int formatted;                                    /* format the metadata in a dict */
   int ret;
 
   /* Obtain and validate the method parameters */
-  if (!PyArg_ParseTuple(args, GET_METADATA_ARGS, &pyeclib_obj_handle, &fragment, &fragment_len, &formatted)) {
+  if (!PyArg_ParseTuple(args, GET_METADATA_ARGS, &pyeclib_obj_handle, &fragment, &formatted)) {
     pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_get_metadata");
     return NULL;
   }
-  pyeclib_handle = (pyeclib_t*)PyCapsule_GetPointer(pyeclib_obj_handle, PYECC_HANDLE_NAME);
-  if (pyeclib_handle == NULL) {
-    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_get_metadata");
-    return NULL;
+  pyeclib_handle = (pyeclib_t*)PyCapsule_GetPointer(pyeclib_obj_handle, PYECC_HANDLE_NAME);
+  if (pyeclib_handle == NULL) {
+    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_get_metadata");
+    PyBuffer_Release(&fragment);
+    return NULL;
+  }
+
+  stats_count_in(fragment.len);
+
+  /* Don't let liberasurecode read past the end of a short buffer */
+  if (fragment.len < (Py_ssize_t) sizeof(fragment_header_t)) {
+    ret = -EBADHEADER;
+  } else {
+    ret = liberasurecode_get_fragment_metadata(fragment.buf, &c_fragment_metadata);
+  }
+  PyBuffer_Release(&fragment);
+
+  if (ret < 0) {
+    pyeclib_c_seterr(ret, "pyeclib_c_get_metadata");
+    fragment_metadata = NULL;
+  } else {
+    if (formatted) {
+      fragment_metadata = fragment_metadata_to_dict(&c_fragment_metadata);
+    } else {
+      fragment_metadata = PY_BUILDVALUE_OBJ_LEN((char*)&c_fragment_metadata,
+                                                  sizeof(fragment_metadata_t));
+    }
+  }
+
+  return fragment_metadata;
+}
+
+/**
+ * Wrap a C array in a python array.array of the given type code.
+ */
+static PyObject *
+new_metadata_column(PyObject *array_module, const char *typecode,
+                    const void *items, Py_ssize_t size)
+{
+  /* y# turns a NULL pointer into None, which array() rejects */
+  return PyObject_CallMethod(array_module, "array", "sy#", typecode,
+                             items ? (const char *) items : "", size);
+}
+
+/**
+ * Turn a batch of fragment metadata into columns, one array.array per field.
+ *
+ * @param metadata array of parsed headers
+ * @param num_fragments number of entries in metadata
+ * @return dict of arrays: index, size, orig_data_size, chksum_type, chksum
+ *         (the first 32 bits of the checksum, which is all of a CRC32),
+ *         chksum_mismatch, backend_id and backend_version; NULL with an
+ *         exception set on error
+ */
+static PyObject *
+fragment_metadata_to_columns(const fragment_metadata_t *metadata,
+                             Py_ssize_t num_fragments)
+{
+  PyObject *array_module = NULL;
+  PyObject *ret_dict = NULL;
+  Py_ssize_t i;
+
+  /* One C array per column, all carved out of a single allocation */
+  unsigned int *index, *size, *chksum, *backend_version;
+  unsigned long long *orig_data_size;
+  unsigned char *chksum_type, *chksum_mismatch, *backend_id;
+  char *columns = NULL;
+
+  columns = (char *) alloc_zeroed_buffer(
+      (sizeof(long long) + 4 * sizeof(int) + 3) * (num_fragments + 1));
+  if (NULL == columns) {
+    pyeclib_c_seterr(-ENOMEM, "fragment_metadata_to_columns");
+    return NULL;
+  }
+  orig_data_size = (unsigned long long *) columns;
+  index = (unsigned int *) (orig_data_size + num_fragments);
+  size = index + num_fragments;
+  chksum = size + num_fragments;
+  backend_version = chksum + num_fragments;
+  chksum_type = (unsigned char *) (backend_version + num_fragments);
+  chksum_mismatch = chksum_type + num_fragments;
+  backend_id = chksum_mismatch + num_fragments;
+
+  for (i = 0; i < num_fragments; i++) {
+    index[i] = metadata[i].idx;
+    size[i] = metadata[i].size;
+    orig_data_size[i] = metadata[i].orig_data_size;
+    chksum_type[i] = metadata[i].chksum_type;
+    chksum[i] = metadata[i].chksum[0];
+    chksum_mismatch[i] = metadata[i].chksum_mismatch;
+    backend_id[i] = metadata[i].backend_id;
+    backend_version[i] = metadata[i].backend_version;
+  }
+
+  array_module = PyImport_ImportModule("array");
+  if (NULL == array_module) {
+    goto exit;
+  }
+  ret_dict = Py_BuildValue(
+    "{s:N, s:N, s:N, s:N, s:N, s:N, s:N, s:N}",
+    "index", new_metadata_column(array_module, "I", index,
+                                 num_fragments * sizeof(int)),
+    "size", new_metadata_column(array_module, "I", size,
+                                num_fragments * sizeof(int)),
+    "orig_data_size", new_metadata_column(array_module, "Q", orig_data_size,
+                                          num_fragments * sizeof(long long)),
+    "chksum_type", new_metadata_column(array_module, "B", chksum_type,
+                                       num_fragments),
+    "chksum", new_metadata_column(array_module, "I", chksum,
+                                  num_fragments * sizeof(int)),
+    "chksum_mismatch", new_metadata_column(array_module, "B", chksum_mismatch,
+                                           num_fragments),
+    "backend_id", new_metadata_column(array_module, "B", backend_id,
+                                      num_fragments),
+    "backend_version", new_metadata_column(array_module, "I", backend_version,
+                                           num_fragments * sizeof(int)));
+
+exit:
+  check_and_free_buffer(columns);
+  Py_XDECREF(array_module);
+  return ret_dict;
+}
+
+/**
+ * Add a column to a dict built by fragment_metadata_to_columns().
+ *
+ * @return 0 on success, -1 with an exception set
+ */
+static int
+add_metadata_column(PyObject *dict, const char *name, const char *typecode,
+                    const void *items, Py_ssize_t size)
+{
+  PyObject *array_module;
+  PyObject *column;
+  int ret;
+
+  array_module = PyImport_ImportModule("array");
+  if (NULL == array_module) {
+    return -1;
+  }
+  column = new_metadata_column(array_module, typecode, items, size);
+  Py_DECREF(array_module);
+  if (NULL == column) {
+    return -1;
+  }
+  ret = PyDict_SetItemString(dict, name, column);
+  Py_DECREF(column);
+  return ret;
+}
+
+/**
+ * Obtain the metadata from a batch of fragments.
+ *
+ * The headers are parsed with the GIL released and returned column by
+ * column, one array.array per field, so no Python object is created per
+ * fragment.  A fragment whose header cannot be parsed does not fail the
+ * batch; its entry in the status column holds the (negative) error code
+ * and its other fields are zero.
+ *
+ * @param pyeclib_obj_handle
+ * @param fragments list of fragments to extract metadata from
+ * @return dict of arrays: status, plus the columns described in
+ *         fragment_metadata_to_columns()
+ */
+static PyObject *
+pyeclib_c_get_metadata_many(PyObject *self, PyObject *args)
+{
+  PyObject *pyeclib_obj_handle = NULL;
+  pyeclib_t *pyeclib_handle = NULL;
+  PyObject *fragments = NULL;                   /* param, list of fragments */
+  Py_buffer *fragment_views = NULL;             /* buffers backing c_fragments */
+  char **c_fragments = NULL;
+  fragment_metadata_t *metadata = NULL;         /* parsed headers */
+  int *status = NULL;                           /* per-fragment return value */
+  PyObject *ret_dict = NULL;
+  int num_fragments = 0;
+  int i, ret;
+
+  if (!PyArg_ParseTuple(args, "OO", &pyeclib_obj_handle, &fragments)) {
+    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_get_metadata_many");
+    return NULL;
+  }
+  pyeclib_handle = (pyeclib_t*)PyCapsule_GetPointer(pyeclib_obj_handle, PYECC_HANDLE_NAME);
+  if (pyeclib_handle == NULL || !PyList_Check(fragments)) {
+    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_get_metadata_many");
+    return NULL;
+  }
+
+  num_fragments = (int) PyList_Size(fragments);
+  c_fragments = (char **) alloc_zeroed_buffer(sizeof(char *) * (num_fragments + 1));
+  metadata = (fragment_metadata_t *) alloc_zeroed_buffer(
+      sizeof(fragment_metadata_t) * (num_fragments + 1));
+  status = (int *) alloc_zeroed_buffer(sizeof(int) * (num_fragments + 1));
+  if (NULL == c_fragments || NULL == metadata || NULL == status) {
+    pyeclib_c_seterr(-ENOMEM, "pyeclib_c_get_metadata_many");
+    goto exit;
+  }
+
+  ret = get_fragment_buffers(fragments, num_fragments, 0, PyBUF_SIMPLE,
+                             &fragment_views, c_fragments);
+  if (ret < 0) {
+    pyeclib_c_seterr(ret, "pyeclib_c_get_metadata_many");
+    goto exit;
+  }
+
+  PYECLIB_BEGIN_NATIVE
+  for (i = 0; i < num_fragments; i++) {
+    /* Don't let liberasurecode read past the end of a short buffer */
+    if (fragment_views[i].len < (Py_ssize_t) sizeof(fragment_header_t)) {
+      status[i] = -EBADHEADER;
+    } else {
+      status[i] = liberasurecode_get_fragment_metadata(c_fragments[i], &metadata[i]);
+    }
+    if (status[i] < 0) {
+      memset(&metadata[i], 0, sizeof(fragment_metadata_t));
+    }
+  }
+  PYECLIB_END_NATIVE
+
+  ret_dict = fragment_metadata_to_columns(metadata, num_fragments);
+  if (NULL != ret_dict &&
+      add_metadata_column(ret_dict, "status", "i", status,
+                          num_fragments * sizeof(int)) < 0) {
+    Py_CLEAR(ret_dict);
+  }
+
+exit:
+  release_fragment_buffers(fragment_views, num_fragments);
+  check_and_free_buffer(c_fragments);
+  check_and_free_buffer(metadata);
+  check_and_free_buffer(status);
+  return ret_dict;
+}
+
+/**
+ * Walk a buffer of back-to-back fragments, such as a fragment archive.
+ *
+ * No handle is needed: each fragment is located from its header alone, a
+ * fragment being sizeof(fragment_header_t) + size +
+ * frag_backend_metadata_size bytes long.  The walk runs with the GIL
+ * released and stops at the end of the buffer or at the first header that
+ * cannot be trusted, as nothing after it can be located.
+ *
+ * @param buffer contiguous buffer of fragments
+ * @param verify_checksums (optional) check the header checksums and fill in
+ *        chksum_mismatch, which reads every byte of fragments carrying an
+ *        inline CRC32 rather than just the headers
+ * @return dict of arrays: offset and length, plus the columns described in
+ *         fragment_metadata_to_columns(); and two ints: scanned, the number
+ *         of bytes walked, and error, 0 or the (negative) error code of the
+ *         fragment that stopped the walk
+ */
+static PyObject *
+pyeclib_c_scan_fragments(PyObject *self, PyObject *args)
+{
+  Py_buffer buffer;                             /* param, fragments */
+  int verify_checksums = 0;                     /* param, check CRCs */
+  fragment_metadata_t *metadata = NULL;         /* one entry per fragment */
+  unsigned long long *offsets = NULL;
+  unsigned long long *lengths = NULL;
+  Py_ssize_t num_fragments = 0;
+  Py_ssize_t capacity = 0;
+  Py_ssize_t offset = 0;
+  PyObject *ret_dict = NULL;
+  PyObject *value = NULL;
+  int err = 0;
+
+  if (!PyArg_ParseTuple(args, "y*|p", &buffer, &verify_checksums)) {
+    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_scan_fragments");
+    return NULL;
+  }
+
+  PYECLIB_BEGIN_NATIVE
+  while (offset < buffer.len) {
+    char *fragment = (char *) buffer.buf + offset;
+    fragment_header_t *header = (fragment_header_t *) fragment;
+    unsigned long long fragment_len;
+
+    if (buffer.len - offset < (Py_ssize_t) sizeof(fragment_header_t) ||
+        header->magic != LIBERASURECODE_FRAG_HEADER_MAGIC) {
+      err = -EBADHEADER;
+      break;
+    }
+    fragment_len = sizeof(fragment_header_t) +
+                   (unsigned long long) header->meta.size +
+                   header->meta.frag_backend_metadata_size;
+    if (fragment_len > (unsigned long long) (buffer.len - offset)) {
+      /* Truncated fragment */
+      err = -EBADHEADER;
+      break;
+    }
+
+    if (num_fragments == capacity) {
+      Py_ssize_t new_capacity = capacity ? 2 * capacity : 64;
+      void *grown;
+
+      grown = realloc(metadata, new_capacity * sizeof(fragment_metadata_t));
+      if (NULL == grown) {
+        err = -ENOMEM;
+        break;
+      }
+      metadata = (fragment_metadata_t *) grown;
+      grown = realloc(offsets, new_capacity * sizeof(unsigned long long));
+      if (NULL == grown) {
+        err = -ENOMEM;
+        break;
+      }
+      offsets = (unsigned long long *) grown;
+      grown = realloc(lengths, new_capacity * sizeof(unsigned long long));
+      if (NULL == grown) {
+        err = -ENOMEM;
+        break;
+      }
+      lengths = (unsigned long long *) grown;
+      capacity = new_capacity;
+    }
+
+    if (verify_checksums) {
+      err = liberasurecode_get_fragment_metadata(fragment, &metadata[num_fragments]);
+      if (err < 0) {
+        break;
+      }
+    } else {
+      memcpy(&metadata[num_fragments], &header->meta, sizeof(fragment_metadata_t));
+      metadata[num_fragments].chksum_mismatch = 0;
+    }
+    offsets[num_fragments] = offset;
+    lengths[num_fragments] = fragment_len;
+    num_fragments++;
+    offset += fragment_len;
+  }
+  PYECLIB_END_NATIVE
+  PyBuffer_Release(&buffer);
+
+  if (err == -ENOMEM) {
+    pyeclib_c_seterr(-ENOMEM, "pyeclib_c_scan_fragments");
+    goto exit;
+  }
+
+  ret_dict = fragment_metadata_to_columns(metadata, num_fragments);
+  if (NULL == ret_dict ||
+      add_metadata_column(ret_dict, "offset", "Q", offsets,
+                          num_fragments * sizeof(unsigned long long)) < 0 ||
+      add_metadata_column(ret_dict, "length", "Q", lengths,
+                          num_fragments * sizeof(unsigned long long)) < 0) {
+    goto error;
+  }
+  value = PyLong_FromSsize_t(offset);
+  if (NULL == value || PyDict_SetItemString(ret_dict, "scanned", value) < 0) {
+    goto error;
+  }
+  Py_DECREF(value);
+  value = PyLong_FromLong(err);
+  if (NULL == value || PyDict_SetItemString(ret_dict, "error", value) < 0) {
+    goto error;
+  }
+  Py_DECREF(value);
+  goto exit;
+
+error:
+  Py_XDECREF(value);
+  Py_CLEAR(ret_dict);
+
+exit:
+  free(metadata);
+  free(offsets);
+  free(lengths);
+  return ret_dict;
+}
+
+/**
+ * Confirm the health of the fragment metadata.
+ *
+ * TODO: Return a list containing tuples (index, problem).  An empty list means
+ * everything is OK.
+ *
+ * @param pyeclib_obj_handle
+ * @param fragment_metadata_list list of fragment metadata headers
+ * @return dictionary containing 'status', 'reason' and 'bad_fragments', depending
+ *         on the status
+ *         NULL if the metadata could not be checked by the liberasurecode
+ */
+static PyObject*
+pyeclib_c_check_metadata(PyObject *self, PyObject *args)
+{
+  PyObject *pyeclib_obj_handle = NULL;
+  pyeclib_t *pyeclib_handle = NULL;
+  PyObject *fragment_metadata_list = NULL;                /* param, fragment metadata */
+  Py_buffer *metadata_views = NULL;                       /* buffers backing the c metadata */
+  fragment_metadata_t *c_fragment_metadata = NULL;        /* metadata buffer for a single fragment */
+  char **c_fragment_metadata_list = NULL;                 /* c version of metadata */
+  int num_fragments;                                      /* k + m from EC algorithm */
+  int k, m;                                               /* EC algorithm params */
+  int size;                                               /* size for buf allocation */
+  int ret = -1;                                           /* c return value */
+  PyObject *ret_obj = NULL;                               /* python long to return */
+  int i = 0;                                              /* a counter */
+
+
+  /* Obtain and validate the method parameters */
+  if (!PyArg_ParseTuple(args, "OO", &pyeclib_obj_handle, &fragment_metadata_list)) {
+    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_check_metadata");
+    return NULL;
+  }
+  pyeclib_handle = (pyeclib_t*)PyCapsule_GetPointer(pyeclib_obj_handle, PYECC_HANDLE_NAME);
+  if (pyeclib_handle == NULL) {
+    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_check_metadata");
+    return NULL;
+  }
+  k = pyeclib_handle->ec_args.k;
+  m = pyeclib_handle->ec_args.m;
+  num_fragments = k + m;
+  PYECLIB_PROBE(check_metadata_entry, PYECLIB_PROBE_HANDLE(pyeclib_handle),
+                num_fragments);
+  if (num_fragments != PyList_Size(fragment_metadata_list)) {
+    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_check_metadata");
+    PYECLIB_PROBE(check_metadata_return, PYECLIB_PROBE_HANDLE(pyeclib_handle),
+                  num_fragments, -EINVALIDPARAMS);
+    return NULL;
+  }
+
+  /* Allocate space for fragment signatures */
+  size = sizeof(char * ) * num_fragments;
+  c_fragment_metadata_list = (char **) alloc_zeroed_buffer(size);
+  if (NULL == c_fragment_metadata_list) {
+    pyeclib_c_seterr(-ENOMEM, "pyeclib_c_check_metadata");
+    goto error;
+  }
+
+  /* Populate the metadata into a C array */
+  ret = get_fragment_buffers(fragment_metadata_list, num_fragments,
+                             sizeof(fragment_metadata_t), PyBUF_SIMPLE,
+                             &metadata_views, c_fragment_metadata_list);
+  if (ret < 0) {
+    pyeclib_c_seterr(ret, "pyeclib_c_check_metadata");
+    goto error;
+  }
+
+  PYECLIB_BEGIN_NATIVE
+  ret = liberasurecode_verify_stripe_metadata(pyeclib_handle->ec_desc, c_fragment_metadata_list,
+                                              num_fragments);
+  PYECLIB_END_NATIVE
+
+  if (ret == 0) {
+    ret_obj = PyDict_New();
+    if (NULL == ret_obj) {
+      pyeclib_c_seterr(-ENOMEM, "pyeclib_c_check_metadata");
+      goto error;
+    }
+    PyDict_SetItemString(ret_obj, "status", PyLong_FromLong((long)0));
+  } else if (ret == -EBADCHKSUM) {
+    ret_obj = PyDict_New();
+    if (NULL == ret_obj) {
+      pyeclib_c_seterr(-ENOMEM, "pyeclib_c_check_metadata");
+      goto error;
+    }
+    PyDict_SetItemString(ret_obj, "status", PyLong_FromLong((long)ret));
+    PyDict_SetItemString(ret_obj, "reason", PyString_FromString("Bad checksum"));
+    PyObject *bad_chksums = PyList_New(0);
+    for (i = 0; i < num_fragments; i++) {
+      c_fragment_metadata = (fragment_metadata_t*)c_fragment_metadata_list[i];
+      if (c_fragment_metadata->chksum_mismatch == 1) {
+        PyList_Append(bad_chksums, PyLong_FromLong((long)c_fragment_metadata->idx));
+      }
+    }
+    PyDict_SetItemString(ret_obj, "bad_fragments", bad_chksums);
+  } else {
+    pyeclib_c_seterr(ret, "pyeclib_c_check_metadata");
+  }
+
+error:
+  release_fragment_buffers(metadata_views, num_fragments);
+  free(c_fragment_metadata_list);
+
+  /* A stripe with bad checksums is a result, not a failure */
+  PYECLIB_PROBE(check_metadata_return, PYECLIB_PROBE_HANDLE(pyeclib_handle),
+                num_fragments,
+                (NULL != ret_obj) ? ret : PYECLIB_PROBE_RC(ret_obj, ret));
+  return ret_obj;
+}
+
+/*
+ * Why verify_stripe() rejected a fragment; indexes verify_stripe_reasons.
+ */
+enum {
+  STRIPE_FRAGMENT_OK = 0,
+  STRIPE_FRAGMENT_BAD_HEADER,
+  STRIPE_FRAGMENT_BAD_CHECKSUM,
+  STRIPE_FRAGMENT_BAD_LENGTH,
+  STRIPE_FRAGMENT_MISMATCH,
+};
+
+static const char *verify_stripe_reasons[] = {
+  "OK",
+  "Bad header",
+  "Bad checksum",
+  "Bad fragment length",
+  "Header disagrees with the rest of the stripe",
+};
+
+/**
+ * Per-call state for pyeclib_c_verify_stripe()
+ */
+typedef struct pyeclib_verify_stripe_s {
+  int num_indexes;                  /* k + m */
+  char **fragments;
+  Py_buffer *views;                 /* buffers backing fragments */
+  fragment_metadata_t *metadata;    /* per fragment, parsed header */
+  int *verdicts;                    /* per fragment, STRIPE_FRAGMENT_* */
+} pyeclib_verify_stripe_t;
+
+static void
+verify_fragment_task(void *arg, int idx)
+{
+  pyeclib_verify_stripe_t *ctx = (pyeclib_verify_stripe_t *) arg;
+  fragment_header_t *header = (fragment_header_t *) ctx->fragments[idx];
+  fragment_metadata_t *metadata = &ctx->metadata[idx];
+  uint64_t expected_len;
+
+  if (ctx->views[idx].len < (Py_ssize_t) sizeof(fragment_header_t) ||
+      header->magic != LIBERASURECODE_FRAG_HEADER_MAGIC) {
+    ctx->verdicts[idx] = STRIPE_FRAGMENT_BAD_HEADER;
+    return;
+  }
+  /* Check the length first so the CRC never runs past the buffer */
+  expected_len = sizeof(fragment_header_t) + (uint64_t) header->meta.size +
+                 header->meta.frag_backend_metadata_size;
+  if ((uint64_t) ctx->views[idx].len != expected_len) {
+    ctx->verdicts[idx] = STRIPE_FRAGMENT_BAD_LENGTH;
+    return;
+  }
+  if (liberasurecode_get_fragment_metadata(ctx->fragments[idx], metadata) < 0 ||
+      metadata->idx >= (uint32_t) ctx->num_indexes) {
+    ctx->verdicts[idx] = STRIPE_FRAGMENT_BAD_HEADER;
+    return;
+  }
+  if (metadata->chksum_mismatch) {
+    ctx->verdicts[idx] = STRIPE_FRAGMENT_BAD_CHECKSUM;
+    return;
+  }
+  ctx->verdicts[idx] = STRIPE_FRAGMENT_OK;
+}
+
+static int
+stripe_headers_agree(const fragment_metadata_t *a, const fragment_metadata_t *b)
+{
+  return a->orig_data_size == b->orig_data_size &&
+         a->size == b->size &&
+         a->backend_id == b->backend_id &&
+         a->backend_version == b->backend_version;
+}
+
+/**
+ * Flag fragments whose header fields disagree with the majority.
+ *
+ * Every fragment of a stripe carries the same orig_data_size, size, backend
+ * id and backend version, so whichever set of values most of the otherwise
+ * healthy fragments share is taken as the truth.
+ */
+static void
+check_stripe_agreement(pyeclib_verify_stripe_t *ctx, int num_fragments)
+{
+  int best = -1, best_votes = 0;
+  int i, j;
+
+  for (i = 0; i < num_fragments; i++) {
+    int votes = 0;
+
+    if (ctx->verdicts[i] != STRIPE_FRAGMENT_OK) {
+      continue;
+    }
+    for (j = 0; j < num_fragments; j++) {
+      if (ctx->verdicts[j] == STRIPE_FRAGMENT_OK &&
+          stripe_headers_agree(&ctx->metadata[i], &ctx->metadata[j])) {
+        votes++;
+      }
+    }
+    if (votes > best_votes) {
+      best = i;
+      best_votes = votes;
+    }
+  }
+  for (i = 0; best >= 0 && i < num_fragments; i++) {
+    if (ctx->verdicts[i] == STRIPE_FRAGMENT_OK &&
+        !stripe_headers_agree(&ctx->metadata[best], &ctx->metadata[i])) {
+      ctx->verdicts[i] = STRIPE_FRAGMENT_MISMATCH;
+    }
+  }
+}
+
+/**
+ * Check a set of fragments from one stripe, payloads included.
+ *
+ * Unlike check_metadata(), which compares headers only, every fragment is
+ * fully verified: header checksum, inline CRC32 over the payload (for
+ * fragments that carry one), fragment length against its header, and
+ * agreement of the header fields shared by all fragments of a stripe.
+ * Fragments are verified on up to num_threads native threads with the GIL
+ * released.
+ *
+ * @param pyeclib_obj_handle
+ * @param fragments list of fragments, typically a whole stripe
+ * @param num_threads (optional) maximum number of threads to verify with
+ * @return dictionary containing 'status', 0 if every fragment is healthy, and
+ *         'bad_fragments', the positions in fragments of unhealthy ones, with
+ *         matching 'reasons'
+ */
+static PyObject *
+pyeclib_c_verify_stripe(PyObject *self, PyObject *args)
+{
+  PyObject *pyeclib_obj_handle = NULL;
+  pyeclib_t *pyeclib_handle = NULL;
+  PyObject *fragments = NULL;       /* param, list of fragments */
+  pyeclib_verify_stripe_t ctx;
+  PyObject *bad_fragments = NULL;
+  PyObject *reasons = NULL;
+  PyObject *ret_dict = NULL;
+  int num_threads = 1;              /* param, number of threads to use */
+  int num_fragments = 0;
+  int status = 0;
+  int i, ret;
+
+  memset(&ctx, 0, sizeof(ctx));
+  if (!PyArg_ParseTuple(args, "OO|i", &pyeclib_obj_handle, &fragments,
+                        &num_threads)) {
+    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_verify_stripe");
+    return NULL;
+  }
+  pyeclib_handle = (pyeclib_t*)PyCapsule_GetPointer(pyeclib_obj_handle, PYECC_HANDLE_NAME);
+  if (pyeclib_handle == NULL || !PyList_Check(fragments) || num_threads < 1) {
+    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_verify_stripe");
+    return NULL;
+  }
+
+  num_fragments = (int) PyList_Size(fragments);
+  ctx.num_indexes = pyeclib_handle->ec_args.k + pyeclib_handle->ec_args.m;
+  ctx.fragments = (char **) alloc_zeroed_buffer(sizeof(char *) * (num_fragments + 1));
+  ctx.metadata = (fragment_metadata_t *) alloc_zeroed_buffer(
+      sizeof(fragment_metadata_t) * (num_fragments + 1));
+  ctx.verdicts = (int *) alloc_zeroed_buffer(sizeof(int) * (num_fragments + 1));
+  if (NULL == ctx.fragments || NULL == ctx.metadata || NULL == ctx.verdicts) {
+    pyeclib_c_seterr(-ENOMEM, "pyeclib_c_verify_stripe");
+    goto exit;
+  }
+
+  ret = get_fragment_buffers(fragments, num_fragments, 0, PyBUF_SIMPLE,
+                             &ctx.views, ctx.fragments);
+  if (ret < 0) {
+    pyeclib_c_seterr(ret, "pyeclib_c_verify_stripe");
+    goto exit;
+  }
+
+  PYECLIB_BEGIN_NATIVE
+  run_tasks(verify_fragment_task, &ctx, num_fragments, num_threads);
+  check_stripe_agreement(&ctx, num_fragments);
+  PYECLIB_END_NATIVE
+
+  bad_fragments = PyList_New(0);
+  reasons = PyList_New(0);
+  if (NULL == bad_fragments || NULL == reasons) {
+    goto exit;
+  }
+  for (i = 0; i < num_fragments; i++) {
+    PyObject *position, *reason;
+
+    if (ctx.verdicts[i] == STRIPE_FRAGMENT_OK) {
+      continue;
+    }
+    if (status == 0) {
+      status = ctx.verdicts[i] == STRIPE_FRAGMENT_BAD_CHECKSUM ?
+        -EBADCHKSUM : -EBADHEADER;
+    }
+    position = PyLong_FromLong(i);
+    reason = PyUnicode_FromString(verify_stripe_reasons[ctx.verdicts[i]]);
+    ret = (NULL == position || NULL == reason ||
+           PyList_Append(bad_fragments, position) < 0 ||
+           PyList_Append(reasons, reason) < 0) ? -1 : 0;
+    Py_XDECREF(position);
+    Py_XDECREF(reason);
+    if (ret < 0) {
+      goto exit;
+    }
+  }
+
+  ret_dict = Py_BuildValue("{s:i, s:O, s:O}", "status", status,
+                           "bad_fragments", bad_fragments, "reasons", reasons);
+
+exit:
+  release_fragment_buffers(ctx.views, num_fragments);
+  check_and_free_buffer(ctx.fragments);
+  check_and_free_buffer(ctx.metadata);
+  check_and_free_buffer(ctx.verdicts);
+  Py_XDECREF(bad_fragments);
+  Py_XDECREF(reasons);
+  return ret_dict;
+}
+
+/**
+ * Re-encode a stripe from its data and compare the result with every
+ * supplied fragment.
+ *
+ * This catches fragments that are internally consistent, so pass their
+ * checksums, but hold the wrong bytes: stale or mis-encoded parity.  The
+ * payload is taken straight from the data fragments when a systematic
+ * backend has all of them, and from liberasurecode_decode() otherwise.  All
+ * of the work, including the comparison, is done with the GIL released and
+ * no Python object is created for the recomputed fragments.
+ *
+ * @param pyeclib_obj_handle
+ * @param fragments list of fragments, typically a whole stripe
+ * @return python list of the indexes of fragments whose payload differs from
+ *         the re-encoded one; empty if the stripe is consistent
+ */
+static PyObject *
+pyeclib_c_scrub_stripe(PyObject *self, PyObject *args)
+{
+  PyObject *pyeclib_obj_handle = NULL;
+  pyeclib_t *pyeclib_handle = NULL;
+  PyObject *fragments = NULL;       /* param, list of fragments */
+  Py_buffer *fragment_views = NULL; /* buffers backing c_fragments */
+  char **c_fragments = NULL;
+  char *decoded = NULL;             /* payload from liberasurecode_decode() */
+  char **encoded_data = NULL;
+  char **encoded_parity = NULL;
+  uint64_t encoded_len = 0;
+  uint64_t decoded_len = 0;
+  int *mismatched = NULL;           /* per fragment, payload differs */
+  PyObject *ret_list = NULL;
+  int num_fragments = 0;
+  int fragment_len;
+  int k, m;
+  int i, ret;
+
+  if (!PyArg_ParseTuple(args, "OO", &pyeclib_obj_handle, &fragments)) {
+    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_scrub_stripe");
+    return NULL;
+  }
+  pyeclib_handle = (pyeclib_t*)PyCapsule_GetPointer(pyeclib_obj_handle, PYECC_HANDLE_NAME);
+  if (pyeclib_handle == NULL || !PyList_Check(fragments)) {
+    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_scrub_stripe");
+    return NULL;
+  }
+  k = pyeclib_handle->ec_args.k;
+  m = pyeclib_handle->ec_args.m;
+
+  num_fragments = (int) PyList_Size(fragments);
+  if (num_fragments < 1) {
+    pyeclib_c_seterr(-EINSUFFFRAGS, "pyeclib_c_scrub_stripe");
+    return NULL;
+  }
+  c_fragments = (char **) alloc_zeroed_buffer(sizeof(char *) * num_fragments);
+  mismatched = (int *) alloc_zeroed_buffer(sizeof(int) * num_fragments);
+  if (NULL == c_fragments || NULL == mismatched) {
+    pyeclib_c_seterr(-ENOMEM, "pyeclib_c_scrub_stripe");
+    goto exit;
+  }
+
+  ret = get_fragment_buffers(fragments, num_fragments, sizeof(fragment_header_t),
+                             PyBUF_SIMPLE, &fragment_views, c_fragments);
+  if (ret < 0) {
+    pyeclib_c_seterr(ret, "pyeclib_c_scrub_stripe");
+    goto exit;
+  }
+  fragment_len = (int) fragment_views[0].len;
+  for (i = 1; i < num_fragments; i++) {
+    if (fragment_views[i].len < fragment_len) {
+      fragment_len = (int) fragment_views[i].len;
+    }
+  }
+  for (i = 0; i < num_fragments; i++) {
+    fragment_header_t *header = (fragment_header_t *) c_fragments[i];
+
+    if (header->magic != LIBERASURECODE_FRAG_HEADER_MAGIC ||
+        header->meta.idx >= (uint32_t) (k + m)) {
+      pyeclib_c_seterr(-EBADHEADER, "pyeclib_c_scrub_stripe");
+      goto exit;
+    }
   }
 
-  ret = liberasurecode_get_fragment_metadata(fragment, &c_fragment_metadata);
+  PYECLIB_BEGIN_NATIVE
+  ret = liberasurecode_decode(pyeclib_handle->ec_desc, c_fragments,
+                              num_fragments, fragment_len, 0,
+                              &decoded, &decoded_len);
+  if (ret == 0) {
+    ret = liberasurecode_encode(pyeclib_handle->ec_desc, decoded,
+                                decoded_len, &encoded_data,
+                                &encoded_parity, &encoded_len);
+  }
+  for (i = 0; ret == 0 && i < num_fragments; i++) {
+    fragment_header_t *header = (fragment_header_t *) c_fragments[i];
+    int idx = header->meta.idx;
+    char *expected = idx < k ? encoded_data[idx] : encoded_parity[idx - k];
+    fragment_header_t *expected_header = (fragment_header_t *) expected;
+    uint32_t size = expected_header->meta.size;
+
+    mismatched[i] = header->meta.size != size ||
+                    (uint64_t) fragment_views[i].len < sizeof(fragment_header_t) + size ||
+                    memcmp(c_fragments[i] + sizeof(fragment_header_t),
+                           expected + sizeof(fragment_header_t), size) != 0;
+  }
+  if (NULL != encoded_data) {
+    liberasurecode_encode_cleanup(pyeclib_handle->ec_desc, encoded_data,
+                                  encoded_parity);
+  }
+  if (NULL != decoded) {
+    liberasurecode_decode_cleanup(pyeclib_handle->ec_desc, decoded);
+  }
+  PYECLIB_END_NATIVE
 
   if (ret < 0) {
-    pyeclib_c_seterr(ret, "pyeclib_c_get_metadata");
-    fragment_metadata = NULL;
-  } else {
-    if (formatted) {
-      fragment_metadata = fragment_metadata_to_dict(&c_fragment_metadata);
-    } else {
-      fragment_metadata = PY_BUILDVALUE_OBJ_LEN((char*)&c_fragment_metadata,
-                                                  sizeof(fragment_metadata_t));
+    pyeclib_c_seterr(ret, "pyeclib_c_scrub_stripe");
+    goto exit;
+  }
+
+  ret_list = PyList_New(0);
+  for (i = 0; NULL != ret_list && i < num_fragments; i++) {
+    PyObject *idx;
+
+    if (!mismatched[i]) {
+      continue;
+    }
+    idx = PyLong_FromLong(((fragment_header_t *) c_fragments[i])->meta.idx);
+    if (NULL == idx || PyList_Append(ret_list, idx) < 0) {
+      Py_CLEAR(ret_list);
     }
+    Py_XDECREF(idx);
   }
 
-  return fragment_metadata;
+exit:
+  release_fragment_buffers(fragment_views, num_fragments);
+  check_and_free_buffer(c_fragments);
+  check_and_free_buffer(mismatched);
+  return ret_list;
 }
 
 /**
- * Confirm the health of the fragment metadata.
+ * Time an operation run straight against liberasurecode.
  *
- * TODO: Return a list containing tuples (index, problem).  An empty list means
- * everything is OK.
+ * This is the baseline for measuring what the binding itself costs: the
+ * same liberasurecode calls that encode(), decode() and reconstruct() make,
+ * results freed as they would be, but called in a loop with the GIL released
+ * and without creating any Python object or copying any buffer.
  *
  * @param pyeclib_obj_handle
- * @param fragment_metadata_list list of fragment metadata headers
- * @return dictionary containing 'status', 'reason' and 'bad_fragments', depending
- *         on the status
- *         NULL if the metadata could not be checked by the liberasurecode
+ * @param op "encode", "decode" or "reconstruct"
+ * @param payload buffer to encode, or list of fragments to decode or
+ *        reconstruct from
+ * @param iterations number of calls to time
+ * @param index (optional) index of the fragment to reconstruct
+ * @return total elapsed time in nanoseconds
  */
-static PyObject*
-pyeclib_c_check_metadata(PyObject *self, PyObject *args)
+static PyObject *
+pyeclib_c_bench_native(PyObject *self, PyObject *args)
 {
   PyObject *pyeclib_obj_handle = NULL;
   pyeclib_t *pyeclib_handle = NULL;
-  PyObject *fragment_metadata_list = NULL;                /* param, fragment metadata */
-  fragment_metadata_t *c_fragment_metadata = NULL;        /* metadata buffer for a single fragment */
-  char **c_fragment_metadata_list = NULL;                 /* c version of metadata */
-  int num_fragments;                                      /* k + m from EC algorithm */
-  int k, m;                                               /* EC algorithm params */
-  int size;                                               /* size for buf allocation */
-  int ret = -1;                                           /* c return value */
-  PyObject *ret_obj = NULL;                               /* python long to return */
-  int i = 0;                                              /* a counter */
-
-
-  /* Obtain and validate the method parameters */
-  if (!PyArg_ParseTuple(args, "OO", &pyeclib_obj_handle, &fragment_metadata_list)) {
-    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_check_metadata");
+  const char *op;                   /* param, operation to time */
+  PyObject *payload = NULL;         /* param, data or fragments */
+  Py_buffer data;                   /* buffer backing payload, for encode */
+  Py_buffer *fragment_views = NULL; /* buffers backing c_fragments */
+  char **c_fragments = NULL;
+  char *c_reconstructed = NULL;
+  int iterations;                   /* param, number of calls */
+  int index = 0;                    /* param, fragment to reconstruct */
+  int num_fragments = 0;
+  int fragment_len = 0;
+  uint64_t start, elapsed = 0;
+  PyObject *ret_obj = NULL;
+  int i, ret = 0;
+
+  data.obj = NULL;
+  if (!PyArg_ParseTuple(args, "OsOi|i", &pyeclib_obj_handle, &op, &payload,
+                        &iterations, &index)) {
+    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_bench_native");
     return NULL;
   }
   pyeclib_handle = (pyeclib_t*)PyCapsule_GetPointer(pyeclib_obj_handle, PYECC_HANDLE_NAME);
-  if (pyeclib_handle == NULL) {
-    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_check_metadata");
-    return NULL;
-  }
-  k = pyeclib_handle->ec_args.k;
-  m = pyeclib_handle->ec_args.m;
-  num_fragments = k + m;
-  if (num_fragments != PyList_Size(fragment_metadata_list)) {
-    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_check_metadata");
+  if (pyeclib_handle == NULL || iterations < 0) {
+    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_bench_native");
     return NULL;
   }
 
-  /* Allocate space for fragment signatures */
-  size = sizeof(char * ) * num_fragments;
-  c_fragment_metadata_list = (char **) alloc_zeroed_buffer(size);
-  if (NULL == c_fragment_metadata_list) {
-    pyeclib_c_seterr(-ENOMEM, "pyeclib_c_check_metadata");
-    goto error;
+  if (strcmp(op, "encode") == 0) {
+    if (PyObject_GetBuffer(payload, &data, PyBUF_SIMPLE) < 0) {
+      pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_bench_native");
+      return NULL;
+    }
+    PYECLIB_BEGIN_NATIVE
+    start = monotonic_ns();
+    for (i = 0; ret == 0 && i < iterations; i++) {
+      char **encoded_data = NULL, **encoded_parity = NULL;
+      uint64_t encoded_len;
+
+      ret = liberasurecode_encode(pyeclib_handle->ec_desc, data.buf, data.len,
+                                  &encoded_data, &encoded_parity, &encoded_len);
+      if (ret == 0) {
+        liberasurecode_encode_cleanup(pyeclib_handle->ec_desc, encoded_data,
+                                      encoded_parity);
+      }
+    }
+    elapsed = monotonic_ns() - start;
+    PYECLIB_END_NATIVE
+    goto exit;
   }
 
-  /* Populate the metadata into a C array */
-  for (i = 0; i < num_fragments; i++) {
-    PyObject *tmp_data = PyList_GetItem(fragment_metadata_list, i);
-    Py_ssize_t len = 0;
-    PyBytes_AsStringAndSize(tmp_data, &(c_fragment_metadata_list[i]), &len);
+  if ((strcmp(op, "decode") != 0 && strcmp(op, "reconstruct") != 0) ||
+      !PyList_Check(payload) || PyList_Size(payload) < 1) {
+    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_bench_native");
+    return NULL;
   }
-
-  ret = liberasurecode_verify_stripe_metadata(pyeclib_handle->ec_desc, c_fragment_metadata_list,
-                                              num_fragments);
-
-  if (ret == 0) {
-    ret_obj = PyDict_New();
-    if (NULL == ret_obj) {
-      pyeclib_c_seterr(-ENOMEM, "pyeclib_c_check_metadata");
-      goto error;
-    }
-    PyDict_SetItemString(ret_obj, "status", PyLong_FromLong((long)0));
-  } else if (ret == -EBADCHKSUM) {
-    ret_obj = PyDict_New();
-    if (NULL == ret_obj) {
-      pyeclib_c_seterr(-ENOMEM, "pyeclib_c_check_metadata");
-      goto error;
+  num_fragments = (int) PyList_Size(payload);
+  c_fragments = (char **) alloc_zeroed_buffer(sizeof(char *) * num_fragments);
+  if (NULL == c_fragments) {
+    pyeclib_c_seterr(-ENOMEM, "pyeclib_c_bench_native");
+    goto exit;
+  }
+  ret = get_fragment_buffers(payload, num_fragments, 0, PyBUF_SIMPLE,
+                             &fragment_views, c_fragments);
+  if (ret < 0) {
+    pyeclib_c_seterr(ret, "pyeclib_c_bench_native");
+    goto exit;
+  }
+  fragment_len = (int) fragment_views[0].len;
+  for (i = 1; i < num_fragments; i++) {
+    if (fragment_views[i].len < fragment_len) {
+      fragment_len = (int) fragment_views[i].len;
     }
-    PyDict_SetItemString(ret_obj, "status", PyLong_FromLong((long)ret));
-    PyDict_SetItemString(ret_obj, "reason", PyString_FromString("Bad checksum"));
-    PyObject *bad_chksums = PyList_New(0);
-    for (i = 0; i < num_fragments; i++) {
-      c_fragment_metadata = (fragment_metadata_t*)c_fragment_metadata_list[i];
-      if (c_fragment_metadata->chksum_mismatch == 1) {
-        PyList_Append(bad_chksums, PyLong_FromLong((long)c_fragment_metadata->idx));
+  }
+
+  if (op[0] == 'd') {
+    PYECLIB_BEGIN_NATIVE
+    start = monotonic_ns();
+    for (i = 0; ret == 0 && i < iterations; i++) {
+      char *decoded = NULL;
+      uint64_t decoded_len;
+
+      ret = liberasurecode_decode(pyeclib_handle->ec_desc, c_fragments,
+                                  num_fragments, fragment_len, 0,
+                                  &decoded, &decoded_len);
+      if (ret == 0) {
+        liberasurecode_decode_cleanup(pyeclib_handle->ec_desc, decoded);
       }
     }
-    PyDict_SetItemString(ret_obj, "bad_fragments", bad_chksums);
+    elapsed = monotonic_ns() - start;
+    PYECLIB_END_NATIVE
   } else {
-    pyeclib_c_seterr(ret, "pyeclib_c_check_metadata");
+    c_reconstructed = (char *) alloc_zeroed_buffer(fragment_len);
+    if (NULL == c_reconstructed) {
+      pyeclib_c_seterr(-ENOMEM, "pyeclib_c_bench_native");
+      goto exit;
+    }
+    PYECLIB_BEGIN_NATIVE
+    start = monotonic_ns();
+    for (i = 0; ret == 0 && i < iterations; i++) {
+      ret = liberasurecode_reconstruct_fragment(pyeclib_handle->ec_desc,
+                                                c_fragments, num_fragments,
+                                                fragment_len, index,
+                                                c_reconstructed);
+    }
+    elapsed = monotonic_ns() - start;
+    PYECLIB_END_NATIVE
   }
 
-error:
-  free(c_fragment_metadata_list);
-
+exit:
+  if (NULL != data.obj) {
+    PyBuffer_Release(&data);
+  }
+  release_fragment_buffers(fragment_views, num_fragments);
+  check_and_free_buffer(c_fragments);
+  check_and_free_buffer(c_reconstructed);
+  if (ret < 0) {
+    if (!PyErr_Occurred()) {
+      pyeclib_c_seterr(ret, "pyeclib_c_bench_native");
+    }
+  } else if (!PyErr_Occurred()) {
+    ret_obj = PyLong_FromUnsignedLongLong(elapsed);
+  }
   return ret_obj;
 }
 
@@ -1218,18 +4233,362 @@ pyeclib_c_liberasurecode_version(PyObject *self, PyObject *args) {
     return Py_BuildValue("k", liberasurecode_get_version());
 }
 
+/**
+ * Incremental encoder for segmented streams.
+ *
+ * Data is fed in arbitrary-sized chunks and buffered until a whole segment
+ * can be encoded.  A segment is only emitted once at least
+ * segment_size + min_segment_size bytes are buffered, so whatever is left
+ * for the final segment is never smaller than the minimum encode size.
+ * finish() then encodes the remainder, which is at most
+ * segment_size + min_segment_size - 1 bytes.  The result matches the
+ * segmentation described by pyeclib_c_get_segment_info() without the caller
+ * needing to know the total length up front, and memory use is bounded by
+ * one segment regardless of the stream length.
+ */
+typedef struct {
+  PyObject_HEAD
+  PyObject *handle;                 /* capsule of the pyeclib_t in use */
+  PyThread_type_lock lock;          /* serializes feed()/finish() */
+  char *buf;                        /* segment_size + min_segment_size bytes */
+  Py_ssize_t buffered;
+  Py_ssize_t capacity;
+  int segment_size;
+  int num_segments;                 /* segments emitted so far */
+  int finished;
+} pyeclib_stream_encoder_t;
+
+static PyTypeObject *StreamEncoderType = NULL;
+
+/*
+ * Copies into the buffer of at least this many bytes are made with the GIL
+ * released.  For smaller ones, waiting to get the GIL back would cost more
+ * than the copy itself.
+ */
+#define STREAM_COPY_NOGIL_BYTES (64 * 1024)
+
+static PyObject *
+stream_encoder_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+  pyeclib_stream_encoder_t *self;
+  PyObject *pyeclib_obj_handle = NULL;
+  pyeclib_t *pyeclib_handle = NULL;
+  int segment_size;
+  int min_segment_size;
+  static char *kwlist[] = {"handle", "segment_size", NULL};
+
+  if (!PyArg_ParseTupleAndKeywords(args, kwds, "Oi", kwlist,
+                                   &pyeclib_obj_handle, &segment_size)) {
+    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_stream_encoder");
+    return NULL;
+  }
+  pyeclib_handle = (pyeclib_t*)PyCapsule_GetPointer(pyeclib_obj_handle, PYECC_HANDLE_NAME);
+  if (pyeclib_handle == NULL || segment_size <= 0) {
+    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_stream_encoder");
+    return NULL;
+  }
+  min_segment_size = liberasurecode_get_minimum_encode_size(pyeclib_handle->ec_desc);
+  if (min_segment_size < 0 || segment_size > INT_MAX - min_segment_size) {
+    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_stream_encoder");
+    return NULL;
+  }
+
+  self = (pyeclib_stream_encoder_t *) type->tp_alloc(type, 0);
+  if (NULL == self) {
+    return NULL;
+  }
+  self->capacity = (Py_ssize_t) segment_size + min_segment_size;
+  self->segment_size = segment_size;
+  self->buf = (char *) malloc(self->capacity);
+  self->lock = PyThread_allocate_lock();
+  if (NULL == self->buf || NULL == self->lock) {
+    Py_DECREF(self);
+    pyeclib_c_seterr(-ENOMEM, "pyeclib_c_stream_encoder");
+    return NULL;
+  }
+  Py_INCREF(pyeclib_obj_handle);
+  self->handle = pyeclib_obj_handle;
+  return (PyObject *) self;
+}
+
+static void
+stream_encoder_dealloc(PyObject *obj)
+{
+  pyeclib_stream_encoder_t *self = (pyeclib_stream_encoder_t *) obj;
+  PyTypeObject *tp = Py_TYPE(obj);
+
+  Py_XDECREF(self->handle);
+  check_and_free_buffer(self->buf);
+  if (NULL != self->lock) {
+    PyThread_free_lock(self->lock);
+  }
+  tp->tp_free(obj);
+  Py_DECREF(tp);
+}
+
+static void
+stream_encoder_lock(pyeclib_stream_encoder_t *self)
+{
+  if (!PyThread_acquire_lock(self->lock, NOWAIT_LOCK)) {
+    Py_BEGIN_ALLOW_THREADS
+    PyThread_acquire_lock(self->lock, WAIT_LOCK);
+    Py_END_ALLOW_THREADS
+  }
+}
+
+/**
+ * Encode the first len bytes of the buffer and append the fragments to out.
+ *
+ * @return 0 on success, -1 with an error set
+ */
+static int
+stream_encoder_emit(pyeclib_stream_encoder_t *self, Py_ssize_t len, PyObject *out)
+{
+  pyeclib_t *pyeclib_handle;
+  pyeclib_call_t call;
+  char **encoded_data = NULL;
+  char **encoded_parity = NULL;
+  uint64_t fragment_len;
+  PyObject *fragments;
+  int ret;
+
+  pyeclib_handle = pyeclib_handle_acquire(self->handle, "pyeclib_c_stream_encoder");
+  if (NULL == pyeclib_handle) {
+    return -1;
+  }
+  /* Each segment counts as one encode() call */
+  stats_call_begin(&call, pyeclib_handle, PYECLIB_OP_ENCODE);
+  stats_count_in(len);
+  PYECLIB_BEGIN_NATIVE
+  ret = liberasurecode_encode(pyeclib_handle->ec_desc, self->buf, len,
+                              &encoded_data, &encoded_parity, &fragment_len);
+  PYECLIB_END_NATIVE
+  if (ret < 0) {
+    pyeclib_c_seterr(ret, "pyeclib_c_stream_encoder");
+    stats_call_end(&call, 1);
+    pyeclib_handle_release(pyeclib_handle);
+    return -1;
+  }
+  fragments = encoded_fragments_to_list(pyeclib_handle->ec_args.k,
+                                        pyeclib_handle->ec_args.m,
+                                        encoded_data, encoded_parity,
+                                        fragment_len);
+  liberasurecode_encode_cleanup(pyeclib_handle->ec_desc, encoded_data, encoded_parity);
+  if (NULL != fragments) {
+    stats_count_result(fragments);
+  }
+  stats_call_end(&call, NULL == fragments);
+  pyeclib_handle_release(pyeclib_handle);
+  if (NULL == fragments) {
+    return -1;
+  }
+  ret = PyList_Append(out, fragments);
+  Py_DECREF(fragments);
+  if (ret < 0) {
+    return -1;
+  }
+
+  /* Keep whatever followed the segment for the next one */
+  self->buffered -= len;
+  memmove(self->buf, self->buf + len, self->buffered);
+  self->num_segments++;
+  return 0;
+}
+
+/**
+ * Add data to the stream.
+ *
+ * @param data any contiguous buffer
+ * @return list of fragment lists, one per segment completed by this data
+ */
+static PyObject *
+stream_encoder_feed(PyObject *obj, PyObject *args)
+{
+  pyeclib_stream_encoder_t *self = (pyeclib_stream_encoder_t *) obj;
+  Py_buffer data;
+  PyObject *out = NULL;
+  Py_ssize_t offset = 0;
+
+  if (!PyArg_ParseTuple(args, "y*", &data)) {
+    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_stream_encoder_feed");
+    return NULL;
+  }
+  stream_encoder_lock(self);
+  if (self->finished) {
+    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_stream_encoder_feed");
+    goto exit;
+  }
+  out = PyList_New(0);
+  if (NULL == out) {
+    goto exit;
+  }
+
+  while (offset < data.len) {
+    Py_ssize_t n = self->capacity - self->buffered;
+
+    if (n > data.len - offset) {
+      n = data.len - offset;
+    }
+    /*
+     * self->lock keeps other callers out of the buffer, and data stays
+     * exported until it is released below
+     */
+    if (n >= STREAM_COPY_NOGIL_BYTES) {
+      Py_BEGIN_ALLOW_THREADS
+      memcpy(self->buf + self->buffered, (char *) data.buf + offset, n);
+      Py_END_ALLOW_THREADS
+    } else {
+      memcpy(self->buf + self->buffered, (char *) data.buf + offset, n);
+    }
+    self->buffered += n;
+    offset += n;
+
+    /* A full buffer guarantees a large enough tail after this segment */
+    if (self->buffered == self->capacity &&
+        stream_encoder_emit(self, self->segment_size, out) < 0) {
+      Py_CLEAR(out);
+      goto exit;
+    }
+  }
+
+exit:
+  PyThread_release_lock(self->lock);
+  PyBuffer_Release(&data);
+  return out;
+}
+
+/**
+ * End the stream, encoding whatever data is still buffered.
+ *
+ * A stream that never received any data is encoded as a single empty
+ * segment, just like encode(b"").
+ *
+ * @return list of fragment lists for the final segment
+ */
+static PyObject *
+stream_encoder_finish(PyObject *obj, PyObject *unused)
+{
+  pyeclib_stream_encoder_t *self = (pyeclib_stream_encoder_t *) obj;
+  PyObject *out = NULL;
+
+  stream_encoder_lock(self);
+  if (self->finished) {
+    pyeclib_c_seterr(-EINVALIDPARAMS, "pyeclib_c_stream_encoder_finish");
+    goto exit;
+  }
+  out = PyList_New(0);
+  if (NULL == out) {
+    goto exit;
+  }
+  if ((self->buffered > 0 || self->num_segments == 0) &&
+      stream_encoder_emit(self, self->buffered, out) < 0) {
+    Py_CLEAR(out);
+    goto exit;
+  }
+  self->finished = 1;
+  self->buf = check_and_free_buffer(self->buf);
+
+exit:
+  PyThread_release_lock(self->lock);
+  return out;
+}
+
+static PyObject *
+stream_encoder_get_segment_size(PyObject *obj, void *closure)
+{
+  return PyLong_FromLong(((pyeclib_stream_encoder_t *) obj)->segment_size);
+}
+
+static PyObject *
+stream_encoder_get_num_segments(PyObject *obj, void *closure)
+{
+  return PyLong_FromLong(((pyeclib_stream_encoder_t *) obj)->num_segments);
+}
+
+static PyObject *
+stream_encoder_get_buffered(PyObject *obj, void *closure)
+{
+  return PyLong_FromSsize_t(((pyeclib_stream_encoder_t *) obj)->buffered);
+}
+
+static PyMethodDef stream_encoder_methods[] = {
+    {"feed", stream_encoder_feed, METH_VARARGS, "Add data, returning the fragments of any completed segments"},
+    {"finish", stream_encoder_finish, METH_NOARGS, "Encode the remaining data, returning the fragments of the last segment"},
+    {NULL, NULL, 0, NULL}        /* Sentinel */
+};
+
+static PyGetSetDef stream_encoder_getset[] = {
+    {"segment_size", stream_encoder_get_segment_size, NULL, "Nominal segment size in bytes", NULL},
+    {"num_segments", stream_encoder_get_num_segments, NULL, "Number of segments emitted so far", NULL},
+    {"buffered", stream_encoder_get_buffered, NULL, "Bytes fed but not yet encoded", NULL},
+    {NULL, NULL, NULL, NULL, NULL}        /* Sentinel */
+};
+
+static PyType_Slot stream_encoder_slots[] = {
+  {Py_tp_new, stream_encoder_new},
+  {Py_tp_dealloc, stream_encoder_dealloc},
+  {Py_tp_methods, stream_encoder_methods},
+  {Py_tp_getset, stream_encoder_getset},
+  {Py_tp_doc, "ECStreamEncoder(handle, segment_size)\n\n"
+              "Encode a stream of data segment by segment in bounded memory."},
+  {0, NULL},
+};
+
+static PyType_Spec stream_encoder_spec = {
+  "pyeclib_c.ECStreamEncoder",
+  sizeof(pyeclib_stream_encoder_t),
+  0,
+  Py_TPFLAGS_DEFAULT,
+  stream_encoder_slots,
+};
+
+/* Methods that use a handle, pinned so that destroy() waits for them */
+PINNED_METHOD(pyeclib_c_encode, PYECLIB_OP_ENCODE)
+PINNED_METHOD(pyeclib_c_encode_into, PYECLIB_OP_ENCODE)
+PINNED_METHOD(pyeclib_c_encode_many, PYECLIB_OP_ENCODE)
+PINNED_METHOD(pyeclib_c_encode_segments, PYECLIB_OP_ENCODE)
+PINNED_METHOD(pyeclib_c_decode, PYECLIB_OP_DECODE)
+PINNED_METHOD(pyeclib_c_decode_into, PYECLIB_OP_DECODE)
+PINNED_METHOD(pyeclib_c_decode_many, PYECLIB_OP_DECODE)
+PINNED_METHOD(pyeclib_c_reconstruct, PYECLIB_OP_RECONSTRUCT)
+PINNED_METHOD(pyeclib_c_reconstruct_into, PYECLIB_OP_RECONSTRUCT)
+PINNED_METHOD(pyeclib_c_reconstruct_many, PYECLIB_OP_RECONSTRUCT)
+PINNED_METHOD(pyeclib_c_get_required_fragments, PYECLIB_OP_FRAGMENTS_NEEDED)
+PINNED_METHOD(pyeclib_c_get_segment_info, PYECLIB_OP_OTHER)
+PINNED_METHOD(pyeclib_c_get_metadata, PYECLIB_OP_METADATA)
+PINNED_METHOD(pyeclib_c_get_metadata_many, PYECLIB_OP_METADATA)
+PINNED_METHOD(pyeclib_c_check_metadata, PYECLIB_OP_VERIFY)
+PINNED_METHOD(pyeclib_c_verify_stripe, PYECLIB_OP_VERIFY)
+PINNED_METHOD(pyeclib_c_scrub_stripe, PYECLIB_OP_VERIFY)
+PINNED_METHOD(pyeclib_c_bench_native, PYECLIB_OP_OTHER)
+/* Reading the stats is not itself counted */
+PINNED_METHOD(pyeclib_c_get_stats, -1)
+
 static PyMethodDef PyECLibMethods[] = {
     {"init",  pyeclib_c_init, METH_VARARGS, "Initialize a new erasure encoder/decoder"},
     {"destroy",  pyeclib_c_destroy, METH_O, "Destroy an erasure encoder/decoder"},
-    {"encode",  pyeclib_c_encode, METH_VARARGS, "Create parity using source data"},
-    {"decode",  pyeclib_c_decode, METH_VARARGS, "Recover all lost data/parity"},
-    {"reconstruct",  pyeclib_c_reconstruct, METH_VARARGS, "Recover selective data/parity"},
-    {"get_required_fragments", pyeclib_c_get_required_fragments, METH_VARARGS, "Return the fragments required to reconstruct a set of missing fragments"},
-    {"get_segment_info", pyeclib_c_get_segment_info, METH_VARARGS, "Return segment and fragment size information needed when encoding a segmented stream"},
-    {"get_metadata", pyeclib_c_get_metadata, METH_VARARGS, "Get the integrity checking metadata for a fragment"},
-    {"check_metadata", pyeclib_c_check_metadata, METH_VARARGS, "Check the integrity checking metadata for a set of fragments"},
+    {"encode",  pyeclib_c_encode_pinned, METH_VARARGS, "Create parity using source data"},
+    {"encode_into",  pyeclib_c_encode_into_pinned, METH_VARARGS, "Create parity using source data, writing fragments into caller-supplied buffers"},
+    {"encode_many",  pyeclib_c_encode_many_pinned, METH_VARARGS, "Create parity for a batch of source data in one call"},
+    {"encode_segments",  pyeclib_c_encode_segments_pinned, METH_VARARGS, "Split source data into segments and encode them in parallel"},
+    {"decode",  pyeclib_c_decode_pinned, METH_VARARGS, "Recover all lost data/parity"},
+    {"decode_into",  pyeclib_c_decode_into_pinned, METH_VARARGS, "Recover the original data into a caller-supplied buffer"},
+    {"decode_many",  pyeclib_c_decode_many_pinned, METH_VARARGS, "Recover the original data for a batch of fragment sets in one call"},
+    {"reconstruct",  pyeclib_c_reconstruct_pinned, METH_VARARGS, "Recover selective data/parity"},
+    {"reconstruct_into",  pyeclib_c_reconstruct_into_pinned, METH_VARARGS, "Recover selective data/parity into a caller-supplied buffer"},
+    {"reconstruct_many",  pyeclib_c_reconstruct_many_pinned, METH_VARARGS, "Recover several selective data/parity fragments in one call"},
+    {"get_required_fragments", pyeclib_c_get_required_fragments_pinned, METH_VARARGS, "Return the fragments required to reconstruct a set of missing fragments"},
+    {"get_segment_info", pyeclib_c_get_segment_info_pinned, METH_VARARGS, "Return segment and fragment size information needed when encoding a segmented stream"},
+    {"get_metadata", pyeclib_c_get_metadata_pinned, METH_VARARGS, "Get the integrity checking metadata for a fragment"},
+    {"get_metadata_many", pyeclib_c_get_metadata_many_pinned, METH_VARARGS, "Get the integrity checking metadata for a batch of fragments, as columns"},
+    {"check_metadata", pyeclib_c_check_metadata_pinned, METH_VARARGS, "Check the integrity checking metadata for a set of fragments"},
+    {"verify_stripe", pyeclib_c_verify_stripe_pinned, METH_VARARGS, "Verify the checksums and header agreement of a set of fragments"},
+    {"scrub_stripe", pyeclib_c_scrub_stripe_pinned, METH_VARARGS, "Re-encode a stripe and report fragments that differ from the result"},
+    {"bench_native", pyeclib_c_bench_native_pinned, METH_VARARGS, "Time an operation run straight against liberasurecode"},
+    {"get_stats", pyeclib_c_get_stats_pinned, METH_VARARGS, "Return the per-operation call, byte, time and error counters of a handle"},
     {"get_liberasurecode_version", pyeclib_c_liberasurecode_version, METH_NOARGS, "Get libersaurecode version in use"},
     {"check_backend_available", pyeclib_c_check_backend_available, METH_VARARGS, "Check if a backend is available"},
+    {"scan_fragments", pyeclib_c_scan_fragments, METH_VARARGS, "Walk a buffer of back-to-back fragments and return their boundaries and headers"},
     {NULL, NULL, 0, NULL}        /* Sentinel */
 };
 
@@ -1242,6 +4601,21 @@ MOD_INIT(pyeclib_c)
     if (m == NULL)
         return MOD_ERROR_VAL;
 
+    NativeBufferType = (PyTypeObject *) PyType_FromSpec(&native_buffer_spec);
+    if (NativeBufferType == NULL) {
+        Py_DECREF(m);
+        return MOD_ERROR_VAL;
+    }
+
+    StreamEncoderType = (PyTypeObject *) PyType_FromSpec(&stream_encoder_spec);
+    if (StreamEncoderType == NULL ||
+        PyModule_AddObject(m, "ECStreamEncoder", (PyObject *) StreamEncoderType) < 0) {
+        Py_DECREF(m);
+        return MOD_ERROR_VAL;
+    }
+    /* PyModule_AddObject stole a reference; keep ours for type checks */
+    Py_INCREF(StreamEncoderType);
+
     #ifdef Py_GIL_DISABLED
         if (liberasurecode_get_version() > 0x010701) {
             PyUnstable_Module_SetGIL(m, Py_MOD_GIL_NOT_USED);
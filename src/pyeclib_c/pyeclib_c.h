@@ -27,10 +27,59 @@
 #ifndef __PYEC_LIB_C_H_
 #define __PYEC_LIB_C_H_
 
+/* Operation classes that per-handle statistics are kept for */
+typedef enum {
+  PYECLIB_OP_ENCODE = 0,
+  PYECLIB_OP_DECODE,
+  PYECLIB_OP_RECONSTRUCT,
+  PYECLIB_OP_FRAGMENTS_NEEDED,
+  PYECLIB_OP_METADATA,
+  PYECLIB_OP_VERIFY,
+  PYECLIB_OP_OTHER,
+  PYECLIB_NUM_OPS,
+} pyeclib_op_t;
+
+/* Failed calls, bucketed by the code handed to pyeclib_c_seterr() */
+typedef enum {
+  PYECLIB_ERR_BACKENDNOTAVAIL = 0,
+  PYECLIB_ERR_INSUFFFRAGS,
+  PYECLIB_ERR_BACKENDNOTSUPP,
+  PYECLIB_ERR_INVALIDPARAMS,
+  PYECLIB_ERR_BADCHKSUM,
+  PYECLIB_ERR_BADHEADER,
+  PYECLIB_ERR_NOMEM,
+  PYECLIB_ERR_OTHER,
+  PYECLIB_NUM_ERRS,
+} pyeclib_err_t;
+
+/*
+ * Counters for one operation class.  They are updated with relaxed atomics
+ * and never under the handle lock, so a snapshot need not be consistent
+ * across fields.
+ */
+typedef struct pyeclib_op_stats_s
+{
+  uint64_t        calls;
+  uint64_t        errors;
+  uint64_t        bytes_in;         /* payload and fragment bytes read */
+  uint64_t        bytes_out;        /* payload and fragment bytes produced */
+  uint64_t        bytes_copied;     /* bytes_out copied into new objects */
+  uint64_t        total_ns;         /* wall time of the whole call */
+  uint64_t        native_ns;        /* part of total_ns without the GIL */
+} pyeclib_op_stats_t;
+
 typedef struct pyeclib_s
 {
-  int             ec_desc;
-  struct ec_args  ec_args;
+  int                    ec_desc;
+  struct ec_args         ec_args;
+  ec_backend_id_t        backend_id;
+  pthread_mutex_t        lock;        /* guards the fields below */
+  pthread_cond_t         idle;        /* signalled when in_flight drops to 0 */
+  int                    in_flight;   /* calls currently using the handle */
+  int                    results;     /* zero-copy results using ec_desc */
+  int                    destroyed;   /* set once destroy() has started */
+  pyeclib_op_stats_t     stats[PYECLIB_NUM_OPS];
+  uint64_t               errors[PYECLIB_NUM_ERRS];
 } pyeclib_t;
 
 
@@ -21,11 +21,15 @@
 # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
 # THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+import asyncio
+import gc
+import mmap
 import os
 import queue
 import random
 import resource
 import string
+import sys
 import tempfile
 import threading
 import unittest
@@ -33,7 +37,9 @@ import unittest
 from itertools import combinations
 
 from pyeclib.ec_iface import ECDriver
+from pyeclib.ec_iface import scan_fragments
 from pyeclib.enums import PyECLib_EC_Types
+import pyeclib.core
 import pyeclib.exceptions
 from pyeclib.exceptions import ECBackendInstanceNotAvailable
 from pyeclib.exceptions import ECBackendNotSupported
@@ -44,6 +50,7 @@ from pyeclib.exceptions import ECInvalidParameter
 
 from pyeclib.ec_iface import ALL_EC_TYPES
 from pyeclib.ec_iface import VALID_EC_TYPES
+import pyeclib_c
 
 
 class TestNullDriver(unittest.TestCase):
@@ -217,6 +224,59 @@ class TestPyECLibDriver(unittest.TestCase):
                 results.append(q.get())
             self.assertEqual(len(results), 5)
 
+    def test_close_while_in_use(self):
+        orig_data = os.urandom(64 * 1024)
+        for backend in VALID_EC_TYPES:
+            driver = ECDriver(ec_type=backend, k=10, m=5, local_parity=2)
+            fragments = driver.encode(orig_data)
+            running = threading.Event()
+            failures = []
+
+            def hammer():
+                try:
+                    while True:
+                        self.assertEqual(driver.encode(orig_data), fragments)
+                        self.assertEqual(driver.decode(fragments), orig_data)
+                        driver.reconstruct(fragments[1:], [0])
+                        running.set()
+                except ECBackendInstanceNotAvailable:
+                    # Expected once the handle is closed
+                    pass
+                except Exception as e:
+                    failures.append(e)
+
+            threads = [threading.Thread(target=hammer) for _ in range(4)]
+            for t in threads:
+                t.start()
+            running.wait(10)
+            driver.close()
+            for t in threads:
+                t.join()
+            self.assertEqual([], failures)
+
+    def test_async_methods(self):
+        orig_data = os.urandom(64 * 1024)
+        for backend in VALID_EC_TYPES:
+            driver = ECDriver(ec_type=backend, k=10, m=5, local_parity=2)
+            fragments = driver.encode(orig_data)
+
+            async def run():
+                results = await asyncio.gather(
+                    driver.encode_async(orig_data),
+                    driver.decode_async(fragments[2:]),
+                    driver.decode_async(fragments, [(0, 9)]),
+                    driver.reconstruct_async(fragments[1:], [0]),
+                )
+                with self.assertRaises(ECDriverError):
+                    await driver.decode_async(fragments[:1])
+                return results
+
+            self.assertEqual(
+                asyncio.run(run()),
+                [fragments, orig_data, [orig_data[:10]], fragments[:1]],
+            )
+            driver.close()
+
     def test_valid_algo(self):
         print("")
         for _type in ALL_EC_TYPES:
@@ -408,6 +468,65 @@ class TestPyECLibDriver(unittest.TestCase):
                 str(ctx.exception), "erasure coding handle is closed"
             )
 
+    def test_shared_handles(self):
+        for ec_type in VALID_EC_TYPES:
+            params = {"ec_type": ec_type, "k": 10, "m": 5, "local_parity": 2}
+            drivers = [ECDriver(shared=True, **params) for _ in range(3)]
+            private = ECDriver(**params)
+            other = ECDriver(shared=True, chksum_type="inline_crc32", **params)
+            handle = drivers[0].ec_lib_reference.handle
+            for driver in drivers[1:]:
+                self.assertIs(handle, driver.ec_lib_reference.handle)
+            self.assertIsNot(handle, private.ec_lib_reference.handle)
+            self.assertIsNot(handle, other.ec_lib_reference.handle)
+
+            # The instance outlives all but the last driver using it
+            frags = drivers[0].encode(b"testdata")
+            drivers[0].close()
+            drivers[0].close()
+            self.assertRaises(
+                ECBackendInstanceNotAvailable, drivers[0].encode, b"testdata"
+            )
+            self.assertEqual(drivers[1].decode(frags), b"testdata")
+            drivers[1].close()
+            self.assertEqual(drivers[2].decode(frags), b"testdata")
+            drivers[2].close()
+
+            fresh = ECDriver(shared=True, **params)
+            self.assertIsNot(handle, fresh.ec_lib_reference.handle)
+            self.assertEqual(fresh.decode(frags), b"testdata")
+            for driver in (fresh, private, other):
+                driver.close()
+
+    def test_shared_handles_released_when_dropped(self):
+        for ec_type in VALID_EC_TYPES:
+            params = {"ec_type": ec_type, "k": 10, "m": 5, "local_parity": 2}
+            drivers = [ECDriver(shared=True, **params) for _ in range(3)]
+            handle = drivers[0].ec_lib_reference.handle
+            entries = [
+                entry
+                for entry in pyeclib.core._shared_handles.values()
+                if entry.handle is handle
+            ]
+            self.assertEqual([3], [entry.refs for entry in entries])
+
+            # Neither closed nor collected drivers may leak a reference
+            drivers[0].close()
+            drivers.pop()
+            gc.collect()
+            self.assertEqual(1, entries[0].refs)
+            del drivers
+            gc.collect()
+            self.assertNotIn(
+                entries[0], pyeclib.core._shared_handles.values()
+            )
+            self.assertRaises(
+                ECBackendInstanceNotAvailable,
+                pyeclib_c.encode,
+                handle,
+                b"testdata",
+            )
+
     def test_small_encode(self):
         pyeclib_drivers = self.get_pyeclib_testspec()
         encode_strs = [b"a", b"hello", b"hellohyhi", b"yo"]
@@ -504,6 +623,485 @@ class TestPyECLibDriver(unittest.TestCase):
                     str(exc_mgr.exception),
                 )
 
+    def test_buffer_protocol_inputs(self):
+        pyeclib_drivers = self.get_pyeclib_testspec("inline_crc32")
+        orig_data = os.urandom(4096)
+        with mmap.mmap(-1, len(orig_data)) as mapped:
+            mapped.write(orig_data)
+            for pyeclib_driver in pyeclib_drivers:
+                expected = pyeclib_driver.encode(orig_data)
+                for data in (
+                    bytearray(orig_data),
+                    memoryview(orig_data),
+                    mapped,
+                ):
+                    self.assertEqual(pyeclib_driver.encode(data), expected)
+
+                # Fragments sliced out of one big receive buffer
+                recv_buffer = bytearray(b"".join(expected))
+                fragment_len = len(expected[0])
+                views = [
+                    memoryview(recv_buffer)[i : i + fragment_len]
+                    for i in range(0, len(recv_buffer), fragment_len)
+                ]
+                self.assertEqual(pyeclib_driver.decode(views[2:]), orig_data)
+                self.assertEqual(
+                    pyeclib_driver.decode(
+                        [v.cast("I") for v in views[2:]], [(1, 10)]
+                    ),
+                    [orig_data[1:11]],
+                )
+                self.assertEqual(
+                    pyeclib_driver.reconstruct(views[1:], [0]), expected[:1]
+                )
+                metadata = [pyeclib_driver.get_metadata(v) for v in views]
+                self.assertEqual(
+                    metadata,
+                    [pyeclib_driver.get_metadata(f) for f in expected],
+                )
+                self.assertEqual(
+                    pyeclib_driver.verify_stripe_metadata(
+                        [memoryview(md) for md in metadata]
+                    ),
+                    {"status": 0},
+                )
+
+                with self.assertRaises(ECDriverError):
+                    pyeclib_driver.decode(["not a buffer"] * len(views))
+                with self.assertRaises(ECInvalidFragmentMetadata):
+                    pyeclib_driver.get_metadata(bytearray(10))
+
+    def test_into_caller_buffers(self):
+        pyeclib_drivers = self.get_pyeclib_testspec("inline_crc32")
+        orig_data = os.urandom(10000)
+        for pyeclib_driver in pyeclib_drivers:
+            expected = pyeclib_driver.encode(orig_data)
+            fragment_len = pyeclib_driver.get_segment_info(
+                len(orig_data), len(orig_data)
+            )["fragment_size"]
+            self.assertEqual(fragment_len, len(expected[0]))
+            num_fragments = pyeclib_driver.k + pyeclib_driver.m
+
+            # Encode into slices of a single reusable arena
+            arena = bytearray(fragment_len * num_fragments)
+            outputs = [
+                memoryview(arena)[i : i + fragment_len]
+                for i in range(0, len(arena), fragment_len)
+            ]
+            for _ in range(2):
+                self.assertEqual(
+                    pyeclib_driver.encode_into(orig_data, outputs),
+                    fragment_len,
+                )
+                self.assertEqual([bytes(o) for o in outputs], expected)
+
+            # Oversized buffers are fine; the tail is left untouched
+            big = [bytearray(b"x" * (fragment_len + 7))] * num_fragments
+            pyeclib_driver.encode_into(orig_data, big)
+            self.assertEqual(big[0][fragment_len:], b"x" * 7)
+
+            out = bytearray(len(orig_data) + 3)
+            self.assertEqual(
+                pyeclib_driver.decode_into(outputs[1:], out), len(orig_data)
+            )
+            self.assertEqual(out[: len(orig_data)], orig_data)
+
+            rebuilt = [bytearray(fragment_len), bytearray(fragment_len)]
+            self.assertEqual(
+                pyeclib_driver.reconstruct_into(
+                    outputs[2:], [1, 0], rebuilt
+                ),
+                fragment_len,
+            )
+            self.assertEqual(rebuilt, [expected[1], expected[0]])
+
+            # Undersized or read-only destinations are rejected
+            with self.assertRaises(ECDriverError):
+                pyeclib_driver.encode_into(
+                    orig_data, [bytearray(fragment_len - 1)] * num_fragments
+                )
+            with self.assertRaises(ECDriverError):
+                pyeclib_driver.encode_into(orig_data, expected)
+            with self.assertRaises(ECDriverError):
+                pyeclib_driver.encode_into(orig_data, outputs[1:])
+            with self.assertRaises(ECDriverError):
+                pyeclib_driver.decode_into(
+                    expected, bytearray(len(orig_data) - 1)
+                )
+            with self.assertRaises(ECDriverError):
+                pyeclib_driver.reconstruct_into(
+                    expected[1:], [0], [bytearray(fragment_len - 1)]
+                )
+            with self.assertRaises(ECDriverError):
+                pyeclib_driver.reconstruct_into(expected[1:], [0], [])
+
+    def test_zero_copy_results(self):
+        pyeclib_drivers = self.get_pyeclib_testspec("inline_crc32")
+        orig_data = os.urandom(10000)
+        for pyeclib_driver in pyeclib_drivers:
+            expected = pyeclib_driver.encode(orig_data)
+            views = pyeclib_driver.encode(orig_data, zero_copy=True)
+            self.assertEqual(len(views), len(expected))
+            for view, fragment in zip(views, expected):
+                self.assertIsInstance(view, memoryview)
+                self.assertTrue(view.readonly)
+                self.assertEqual(view, fragment)
+            with self.assertRaises(TypeError):
+                views[0][0] = 0
+
+            decoded = pyeclib_driver.decode(views[2:], zero_copy=True)
+            self.assertIsInstance(decoded, memoryview)
+            self.assertEqual(decoded, orig_data)
+            ranges = pyeclib_driver.decode(
+                views[2:], [(0, 9), (100, 199)], zero_copy=True
+            )
+            self.assertEqual(
+                [bytes(r) for r in ranges],
+                [orig_data[:10], orig_data[100:200]],
+            )
+
+            rebuilt = pyeclib_driver.reconstruct(
+                views[2:], [1, 0], zero_copy=True
+            )
+            self.assertEqual(
+                [bytes(r) for r in rebuilt], [expected[0], expected[1]]
+            )
+
+            # Slices keep the native memory alive after the originals go,
+            # even past closing the driver
+            tail = views[-1][-16:]
+            del views, decoded, ranges, rebuilt
+            self.assertEqual(tail, expected[-1][-16:])
+        for pyeclib_driver in pyeclib_drivers:
+            pyeclib_driver.close()
+        self.assertEqual(tail, expected[-1][-16:])
+
+    def test_encode_many_decode_many(self):
+        pyeclib_drivers = self.get_pyeclib_testspec("inline_crc32")
+        segments = [os.urandom(size) for size in (1, 4096, 5000, 65536)]
+        for pyeclib_driver in pyeclib_drivers:
+            self.assertEqual(pyeclib_driver.encode_many([]), [])
+            self.assertEqual(pyeclib_driver.decode_many([]), [])
+
+            encoded = pyeclib_driver.encode_many(
+                [segments[0], bytearray(segments[1])]
+                + [memoryview(s) for s in segments[2:]]
+            )
+            self.assertEqual(
+                encoded, [pyeclib_driver.encode(s) for s in segments]
+            )
+
+            fragment_sets = [frags[1:] for frags in encoded]
+            self.assertEqual(
+                pyeclib_driver.decode_many(fragment_sets, True), segments
+            )
+
+            # Failures are reported per item, and counted in the stats
+            fragment_sets[1] = encoded[1][: pyeclib_driver.k - 1]
+            fragment_sets[2] = encoded[2][:-1] + [encoded[2][-1][:-1]]
+            pyeclib_driver.stats(reset=True)
+            results = pyeclib_driver.decode_many(fragment_sets)
+            self.assertEqual(results[0], segments[0])
+            self.assertIsInstance(results[1], ECInsufficientFragments)
+            self.assertIsInstance(results[2], ECInvalidParameter)
+            self.assertEqual(results[3], segments[3])
+            stats = pyeclib_driver.stats()
+            self.assertEqual(1, stats["operations"]["decode"]["calls"])
+            self.assertEqual(2, stats["operations"]["decode"]["errors"])
+            self.assertEqual(1, stats["errors"]["ECInsufficientFragments"])
+            self.assertEqual(1, stats["errors"]["ECInvalidParameter"])
+
+            with self.assertRaises(ECDriverError):
+                pyeclib_driver.encode_many([segments[0], "not a buffer"])
+
+            # Large batches are handed back in several chunks
+            large = [os.urandom(100000) for _ in range(6)]
+            encoded = pyeclib_driver.encode_many(large)
+            self.assertEqual(
+                encoded, [pyeclib_driver.encode(s) for s in large]
+            )
+            self.assertEqual(pyeclib_driver.decode_many(encoded), large)
+
+    def test_stream_encoder(self):
+        pyeclib_drivers = self.get_pyeclib_testspec()
+        segment_size = 4096
+        for pyeclib_driver in pyeclib_drivers:
+            for data_len in (
+                0,
+                1,
+                segment_size,
+                segment_size + 1,
+                3 * segment_size,
+                3 * segment_size + 1,
+                5 * segment_size + 3000,
+            ):
+                data = os.urandom(data_len)
+                encoder = pyeclib_driver.stream_encoder(segment_size)
+                self.assertEqual(encoder.segment_size, segment_size)
+                segments = []
+                # Feed in awkward chunk sizes to exercise the buffering
+                for i in range(0, data_len, 1000):
+                    segments.extend(encoder.feed(data[i : i + 1000]))
+                    # Never more than a segment plus a short tail
+                    self.assertLess(encoder.buffered, 2 * segment_size)
+                segments.extend(encoder.finish())
+                self.assertEqual(encoder.num_segments, len(segments))
+
+                if data_len:
+                    info = pyeclib_driver.get_segment_info(
+                        data_len, segment_size
+                    )
+                    self.assertEqual(len(segments), info["num_segments"])
+                    for fragments in segments[:-1]:
+                        self.assertEqual(
+                            len(fragments[0]), info["fragment_size"]
+                        )
+                    self.assertEqual(
+                        len(segments[-1][0]), info["last_fragment_size"]
+                    )
+                else:
+                    self.assertEqual(len(segments), 1)
+
+                decoded = b"".join(
+                    pyeclib_driver.decode(fragments[1:])
+                    for fragments in segments
+                )
+                self.assertEqual(decoded, data)
+
+                with self.assertRaises(ECDriverError):
+                    encoder.feed(b"more")
+                with self.assertRaises(ECDriverError):
+                    encoder.finish()
+
+            # Large feeds are copied with the GIL released
+            data = os.urandom(250000)
+            encoder = pyeclib_driver.stream_encoder(100000)
+            segments = encoder.feed(data[:150000])
+            segments.extend(encoder.feed(memoryview(data)[150000:]))
+            segments.extend(encoder.finish())
+            self.assertEqual(
+                segments, pyeclib_driver.encode_segments(data, 100000)
+            )
+
+            with self.assertRaises(ECDriverError):
+                pyeclib_driver.stream_encoder(0)
+
+    def test_reconstruct_multiple_indexes(self):
+        pyeclib_drivers = self.get_pyeclib_testspec()
+        orig_data = os.urandom(10000)
+        for pyeclib_driver in pyeclib_drivers:
+            fragments = pyeclib_driver.encode(orig_data)
+            k = pyeclib_driver.k
+            n = k + pyeclib_driver.m
+            # Lose a data fragment and a parity fragment that depends on it
+            missing = [n - 1, 0]
+            available = [
+                f for i, f in enumerate(fragments) if i not in missing
+            ]
+            rebuilt = pyeclib_driver.reconstruct(available, missing)
+            self.assertEqual(missing, [0, n - 1])
+            self.assertEqual(rebuilt, [fragments[0], fragments[n - 1]])
+            views = pyeclib_driver.reconstruct(
+                available, [0, n - 1], zero_copy=True
+            )
+            self.assertEqual([bytes(v) for v in views], rebuilt)
+            self.assertEqual(pyeclib_driver.reconstruct(available, []), [])
+            with self.assertRaises(ECDriverError):
+                pyeclib_driver.reconstruct(available, [0, n])
+
+    def test_range_decode(self):
+        pyeclib_drivers = self.get_pyeclib_testspec()
+        orig_data = os.urandom(100000)
+        for pyeclib_driver in pyeclib_drivers:
+            fragments = pyeclib_driver.encode(orig_data)
+            k = pyeclib_driver.k
+            n = k + pyeclib_driver.m
+            column = pyeclib_driver.get_metadata(fragments[0], 1)["size"]
+            ranges = [
+                (0, 0),
+                (10, 109),
+                (column - 5, column + 4),
+                (column, 3 * column - 1),
+                (len(orig_data) - 10, len(orig_data) - 1),
+                (0, len(orig_data) - 1),
+                (50, 49),
+            ]
+            expected = [orig_data[b : e + 1] for b, e in ranges]
+
+            # All data fragments, a missing parity, and missing data
+            # fragments both inside and outside of the ranges
+            for missing in ([], [n - 1], [1], [0, k - 1]):
+                if len(missing) > pyeclib_driver.hd - 1:
+                    continue
+                available = [
+                    f for i, f in enumerate(fragments) if i not in missing
+                ]
+                self.assertEqual(
+                    pyeclib_driver.decode(available, ranges), expected
+                )
+                views = pyeclib_driver.decode(
+                    available, ranges, zero_copy=True
+                )
+                self.assertEqual([bytes(v) for v in views], expected)
+
+            with self.assertRaises(ECInvalidParameter):
+                pyeclib_driver.decode(
+                    fragments, [(0, len(orig_data))]
+                )
+
+            # A parity fragment whose header claims to be the missing data
+            # fragment 1 is rejected, not copied into the range
+            corrupt = bytearray(fragments[k])
+            corrupt[0] = 1
+            available = [bytes(corrupt), fragments[0]] + fragments[2:k]
+            with self.assertRaises(ECInvalidFragmentMetadata):
+                pyeclib_driver.decode(available, [(column, 2 * column - 1)])
+
+    def test_decode_data_fragments(self):
+        pyeclib_drivers = self.get_pyeclib_testspec()
+        for size in (1, 4097, 100003):
+            orig_data = os.urandom(size)
+            for pyeclib_driver in pyeclib_drivers:
+                fragments = pyeclib_driver.encode(orig_data)
+                k = pyeclib_driver.k
+                # Shuffled, with a duplicate and a parity fragment mixed in
+                available = fragments[:k] + fragments[k : k + 1]
+                available.append(fragments[0])
+                random.shuffle(available)
+                self.assertEqual(pyeclib_driver.decode(available), orig_data)
+                view = pyeclib_driver.decode(available, zero_copy=True)
+                self.assertEqual(view, orig_data)
+                output = bytearray(size + 10)
+                self.assertEqual(
+                    pyeclib_driver.decode_into(available, output), size
+                )
+                self.assertEqual(output[:size], orig_data)
+                with self.assertRaises(ECDriverError):
+                    pyeclib_driver.decode_into(
+                        available, bytearray(size - 1)
+                    )
+
+    def test_decode_corrupt_header(self):
+        pyeclib_drivers = self.get_pyeclib_testspec()
+        orig_data = os.urandom(4097)
+        for pyeclib_driver in pyeclib_drivers:
+            fragments = pyeclib_driver.encode(orig_data)
+            k = pyeclib_driver.k
+            # Data fragment 1 is lost, and the first parity fragment's
+            # header claims to be it; only the header checksum can tell
+            corrupt = bytearray(fragments[k])
+            corrupt[0] = 1
+            available = [bytes(corrupt), fragments[0]] + fragments[2:k]
+            with self.assertRaises(ECInvalidFragmentMetadata):
+                pyeclib_driver.decode(available)
+            with self.assertRaises(ECInvalidFragmentMetadata):
+                pyeclib_driver.decode_into(
+                    available, bytearray(len(orig_data))
+                )
+
+    def test_encode_segments(self):
+        pyeclib_drivers = self.get_pyeclib_testspec()
+        segment_size = 4096
+        for pyeclib_driver in pyeclib_drivers:
+            for data_len in (0, 100, 4 * segment_size, 9 * segment_size + 1):
+                data = os.urandom(data_len)
+                encoder = pyeclib_driver.stream_encoder(segment_size)
+                expected = encoder.feed(data) + encoder.finish()
+                for threads in (1, 3, 16):
+                    self.assertEqual(
+                        pyeclib_driver.encode_segments(
+                            memoryview(data), segment_size, threads=threads
+                        ),
+                        expected,
+                    )
+
+            with self.assertRaises(ECDriverError):
+                pyeclib_driver.encode_segments(b"x", 0)
+            with self.assertRaises(ECDriverError):
+                pyeclib_driver.encode_segments(b"x", segment_size, threads=0)
+
+    @unittest.skipUnless(
+        os.path.isdir("/proc/self/task"), "needs Linux's /proc/self/task"
+    )
+    def test_encode_segments_threads_capped_at_cpus(self):
+        if "liberasurecode_rs_vand" not in VALID_EC_TYPES:
+            return
+        driver = ECDriver(k=4, m=2, ec_type="liberasurecode_rs_vand")
+        data = os.urandom(1 << 23)
+        done = threading.Event()
+        peak = []
+
+        def count_threads():
+            while not done.is_set():
+                peak.append(len(os.listdir("/proc/self/task")))
+
+        poller = threading.Thread(target=count_threads)
+        poller.start()
+        try:
+            before = len(os.listdir("/proc/self/task"))
+            # 512 segments, far more than there are CPUs
+            segments = driver.encode_segments(data, 16384, threads=10000)
+        finally:
+            done.set()
+            poller.join()
+        self.assertEqual(len(segments), 512)
+        # The calling thread encodes too, so it needs cpu_count() - 1 more
+        self.assertLessEqual(max(peak), before + os.cpu_count() - 1)
+
+    def test_stream_decoder(self):
+        pyeclib_drivers = self.get_pyeclib_testspec()
+        segment_size = 4096
+        # Short tail gets merged into the last segment
+        data = os.urandom(5 * segment_size + 7)
+        ranges = [
+            (0, 0),
+            (10, 5000),
+            (4 * segment_size + 5, 5 * segment_size + 6),
+            (100, 200),
+            (5 * segment_size + 1, 5 * segment_size + 1),
+        ]
+        for pyeclib_driver in pyeclib_drivers:
+            encoder = pyeclib_driver.stream_encoder(segment_size)
+            segments = encoder.feed(data) + encoder.finish()
+            self.assertEqual(len(segments), 5)
+
+            decoder = pyeclib_driver.stream_decoder(
+                ranges, len(data), segment_size
+            )
+            self.assertEqual(decoder.segments, [0, 1, 4])
+
+            fetched = []
+
+            def fetch():
+                for segment in decoder.segments:
+                    fetched.append(segment)
+                    yield segments[segment][2:]
+
+            pieces = {r: [] for r in ranges}
+            for r, piece in decoder.decode(fetch()):
+                pieces[r].append(piece)
+            self.assertEqual(fetched, [0, 1, 4])
+            for begin, end in ranges:
+                self.assertEqual(
+                    b"".join(pieces[(begin, end)]), data[begin : end + 1]
+                )
+
+            # Running out of segments is an error
+            with self.assertRaises(ECInsufficientFragments):
+                list(decoder.decode(iter(segments[:2])))
+            with self.assertRaises(ECInvalidParameter):
+                pyeclib_driver.stream_decoder(
+                    [(0, len(data))], len(data), segment_size
+                )
+            self.assertEqual(
+                list(
+                    pyeclib_driver.stream_decoder(
+                        [], len(data), segment_size
+                    ).decode([])
+                ),
+                [],
+            )
+
     def check_metadata_formatted(self, k, m, ec_type, chksum_type):
 
         if ec_type not in VALID_EC_TYPES:
@@ -571,6 +1169,147 @@ class TestPyECLibDriver(unittest.TestCase):
             8, 4, "liberasurecode_rs_vand", "inline_crc32"
         )
 
+    def test_get_metadata_many(self):
+        pyeclib_drivers = self.get_pyeclib_testspec("inline_crc32")
+        for pyeclib_driver in pyeclib_drivers:
+            fragments = pyeclib_driver.encode(os.urandom(10000))
+            corrupted = bytearray(fragments[1])
+            corrupted[-1] ^= 0xFF
+            batch = fragments + [bytes(corrupted), b"short"]
+            columns = pyeclib_driver.get_metadata_many(batch)
+            self.assertEqual(
+                [len(column) for column in columns.values()],
+                [len(batch)] * len(columns),
+            )
+            for i, fragment in enumerate(batch[:-1]):
+                metadata = pyeclib_driver.get_metadata(fragment, 1)
+                self.assertEqual(columns["status"][i], 0)
+                for key in (
+                    "index",
+                    "size",
+                    "orig_data_size",
+                    "chksum_mismatch",
+                    "backend_version",
+                ):
+                    self.assertEqual(columns[key][i], metadata[key])
+                self.assertEqual(
+                    columns["chksum"][i].to_bytes(4, sys.byteorder).hex(),
+                    metadata["chksum"][:8],
+                )
+                self.assertEqual(
+                    columns["backend_id"][i], pyeclib_driver.ec_type.value
+                )
+            self.assertEqual(columns["chksum_mismatch"][len(fragments)], 1)
+            self.assertLess(columns["status"][-1], 0)
+            self.assertEqual(columns["size"][-1], 0)
+
+            empty = pyeclib_driver.get_metadata_many([])
+            self.assertEqual([len(c) for c in empty.values()], [0] * 9)
+
+    def test_scan_fragments(self):
+        pyeclib_drivers = self.get_pyeclib_testspec("inline_crc32")
+        for pyeclib_driver in pyeclib_drivers:
+            fragments = []
+            for size in (1, 1000, 100000):
+                fragments.extend(pyeclib_driver.encode(os.urandom(size)))
+            archive = bytearray(b"".join(fragments))
+
+            result = scan_fragments(archive)
+            self.assertEqual(result["error"], 0)
+            self.assertEqual(result["scanned"], len(archive))
+            self.assertEqual(len(result["offset"]), len(fragments))
+            offset = 0
+            for i, fragment in enumerate(fragments):
+                metadata = pyeclib_driver.get_metadata(fragment, 1)
+                self.assertEqual(result["offset"][i], offset)
+                self.assertEqual(result["length"][i], len(fragment))
+                for key in ("index", "size", "orig_data_size"):
+                    self.assertEqual(result[key][i], metadata[key])
+                self.assertEqual(
+                    result["backend_id"][i], pyeclib_driver.ec_type.value
+                )
+                offset += len(fragment)
+
+            # Payload corruption only shows up when checksums are verified
+            archive[result["offset"][1] + result["length"][1] - 1] ^= 0xFF
+            self.assertEqual(
+                list(scan_fragments(archive)["chksum_mismatch"]),
+                [0] * len(fragments),
+            )
+            self.assertEqual(
+                list(scan_fragments(archive, True)["chksum_mismatch"]),
+                [0, 1] + [0] * (len(fragments) - 2),
+            )
+
+            # A truncated fragment stops the walk
+            truncated = scan_fragments(archive[:-1])
+            self.assertLess(truncated["error"], 0)
+            self.assertEqual(truncated["scanned"], result["offset"][-1])
+            self.assertEqual(len(truncated["offset"]), len(fragments) - 1)
+
+        empty = scan_fragments(b"")
+        self.assertEqual((empty["error"], empty["scanned"]), (0, 0))
+        self.assertEqual(len(empty["offset"]), 0)
+
+    def test_verify_stripe(self):
+        pyeclib_drivers = self.get_pyeclib_testspec("inline_crc32")
+        for pyeclib_driver in pyeclib_drivers:
+            fragments = pyeclib_driver.encode(os.urandom(10000))
+            for threads in (1, 4):
+                self.assertEqual(
+                    pyeclib_driver.verify_stripe(fragments, threads),
+                    {"status": 0, "bad_fragments": [], "reasons": []},
+                )
+
+            stripe = list(fragments)
+            # Payload corruption
+            corrupted = bytearray(stripe[1])
+            corrupted[-1] ^= 0xFF
+            stripe[1] = corrupted
+            # Truncation
+            stripe[2] = stripe[2][:-1]
+            # A fragment from some other stripe
+            stripe[3] = pyeclib_driver.encode(os.urandom(20000))[3]
+            # Garbage
+            stripe[4] = b"junk"
+            result = pyeclib_driver.verify_stripe(stripe, 2)
+            self.assertLess(result["status"], 0)
+            self.assertEqual(result["bad_fragments"], [1, 2, 3, 4])
+            self.assertEqual(
+                result["reasons"],
+                [
+                    "Bad checksum",
+                    "Bad fragment length",
+                    "Header disagrees with the rest of the stripe",
+                    "Bad header",
+                ],
+            )
+
+    def test_scrub_stripe(self):
+        pyeclib_drivers = self.get_pyeclib_testspec("inline_crc32")
+        for pyeclib_driver in pyeclib_drivers:
+            k = pyeclib_driver.k
+            fragments = pyeclib_driver.encode(os.urandom(10000))
+            self.assertEqual(pyeclib_driver.scrub_stripe(fragments), [])
+            self.assertEqual(
+                pyeclib_driver.scrub_stripe(fragments[: k + 1]), []
+            )
+            # Missing data fragments are decoded
+            self.assertEqual(pyeclib_driver.scrub_stripe(fragments[1:]), [])
+
+            # Parity that is valid on its own but belongs to another stripe
+            stale = pyeclib_driver.encode(os.urandom(10000))
+            stripe = fragments[:k] + [stale[k]] + fragments[k + 1 :]
+            self.assertEqual(pyeclib_driver.verify_stripe(stripe)["status"], 0)
+            self.assertEqual(pyeclib_driver.scrub_stripe(stripe), [k])
+
+            # Order doesn't matter
+            stripe.reverse()
+            self.assertEqual(pyeclib_driver.scrub_stripe(stripe), [k])
+
+            with self.assertRaises(ECDriverError):
+                pyeclib_driver.scrub_stripe([])
+
     def test_verify_fragment_inline_chksum_fail(self):
         pyeclib_drivers = self.get_pyeclib_testspec("inline_crc32")
         filesize = 1024 * 1024 * 3
@@ -939,6 +1678,61 @@ class TestPyECLibDriver(unittest.TestCase):
                     pyeclib_drivers[0].min_parity_fragments_needed() == 1
                 )
 
+    def test_stats(self):
+        if "liberasurecode_rs_vand" not in VALID_EC_TYPES:
+            return
+        driver = ECDriver(k=4, m=2, ec_type="liberasurecode_rs_vand")
+        payload = b"x" * 1000
+        fragments = driver.encode(payload)
+        fragment_len = len(fragments[0])
+        self.assertEqual(payload, driver.decode(fragments[2:]))
+        self.assertRaises(
+            ECInsufficientFragments, driver.reconstruct, fragments[:2], [5]
+        )
+
+        stats = driver.stats(reset=True)
+        encode = stats["operations"]["encode"]
+        self.assertEqual(1, encode["calls"])
+        self.assertEqual(0, encode["errors"])
+        self.assertEqual(len(payload), encode["bytes_in"])
+        self.assertEqual(6 * fragment_len, encode["bytes_out"])
+        self.assertEqual(6 * fragment_len, encode["bytes_copied"])
+        self.assertGreater(encode["native_ns"], 0)
+        decode = stats["operations"]["decode"]
+        self.assertEqual(1, decode["calls"])
+        self.assertEqual(4 * fragment_len, decode["bytes_in"])
+        self.assertEqual(len(payload), decode["bytes_out"])
+        reconstruct = stats["operations"]["reconstruct"]
+        self.assertEqual(1, reconstruct["calls"])
+        self.assertEqual(1, reconstruct["errors"])
+        self.assertEqual(1, stats["errors"]["ECInsufficientFragments"])
+        self.assertEqual(0, stats["operations"]["verify"]["calls"])
+
+        # Zero-copy results are produced without being copied
+        driver.encode(payload, zero_copy=True)
+        stats = driver.stats()
+        self.assertEqual(0, stats["operations"]["decode"]["calls"])
+        encode = stats["operations"]["encode"]
+        self.assertEqual(6 * fragment_len, encode["bytes_out"])
+        self.assertEqual(0, encode["bytes_copied"])
+        self.assertEqual(0, stats["errors"]["ECInsufficientFragments"])
+
+        # Neither is output written into the caller's buffers
+        driver.stats(reset=True)
+        outputs = [bytearray(fragment_len) for _ in range(6)]
+        driver.encode_into(payload, outputs)
+        output = bytearray(len(payload))
+        driver.decode_into(fragments[2:], output)
+        driver.reconstruct_into(fragments[2:], [0], [outputs[0]])
+        stats = driver.stats(reset=True)
+        for op, produced in (
+            ("encode", 6 * fragment_len),
+            ("decode", len(payload)),
+            ("reconstruct", fragment_len),
+        ):
+            self.assertEqual(produced, stats["operations"][op]["bytes_out"])
+            self.assertEqual(0, stats["operations"][op]["bytes_copied"])
+
     def test_pyeclib_driver_repr_expression(self):
         pyeclib_drivers = self.get_pyeclib_testspec()
         for driver in pyeclib_drivers:
@@ -21,10 +21,15 @@
 # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
 # THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+import os
 import random
+import shutil
 from string import ascii_letters
+import struct
+import subprocess
 import sys
 import tempfile
+import threading
 import time
 import unittest
 
@@ -61,6 +66,45 @@ def require_backend(backend):
     )
 
 
+def read_stapsdt_notes(path):
+    """
+    Return the (provider, name, arguments) of every USDT probe in a 64-bit
+    little-endian ELF file, or an empty list if it has none.
+    """
+    with open(path, "rb") as f:
+        elf = f.read()
+    if elf[:4] != b"\x7fELF" or elf[4] != 2 or elf[5] != 1:
+        return []
+    shoff, = struct.unpack_from("<Q", elf, 0x28)
+    shentsize, shnum, shstrndx = struct.unpack_from("<HHH", elf, 0x3A)
+    sections = [
+        struct.unpack_from("<IIQQQQ", elf, shoff + i * shentsize)
+        for i in range(shnum)
+    ]
+    strtab_offset = sections[shstrndx][4]
+    notes = []
+    for sh_name, _, _, _, offset, size in sections:
+        name_end = elf.index(b"\0", strtab_offset + sh_name)
+        if elf[strtab_offset + sh_name:name_end] != b".note.stapsdt":
+            continue
+        pos = offset
+        while pos < offset + size:
+            namesz, descsz, note_type = struct.unpack_from("<III", elf, pos)
+            pos += 12
+            owner = elf[pos:pos + namesz].rstrip(b"\0")
+            pos += (namesz + 3) & ~3
+            desc = elf[pos:pos + descsz]
+            pos += (descsz + 3) & ~3
+            if owner != b"stapsdt" or note_type != 3:
+                continue
+            # pc, base and semaphore addresses, then three strings
+            provider, name, arguments = desc[24:].split(b"\0")[:3]
+            notes.append(
+                (provider.decode(), name.decode(), arguments.decode().split())
+            )
+    return notes
+
+
 class TestPyECLib(unittest.TestCase):
 
     @classmethod
@@ -592,6 +636,225 @@ class TestPyECLib(unittest.TestCase):
         pyeclib_c.encode(handle2, whole_file_bytes)
         pyeclib_c.destroy(handle2)
 
+    def test_destroy_with_zero_copy_results_alive(self):
+        # liberasurecode_rs_vand should always be available
+        handle = pyeclib_c.init(
+            4, 2, PyECLib_EC_Types.liberasurecode_rs_vand.value, 2
+        )
+        whole_file_bytes = self.get_tmp_file("101-K").read()
+        expected = pyeclib_c.encode(handle, whole_file_bytes)
+        fragment_len = len(expected[0])
+        views = pyeclib_c.encode(handle, whole_file_bytes, True)
+        decoded = pyeclib_c.decode(
+            handle, expected[2:], fragment_len, None, False, True
+        )
+
+        # The views pin the liberasurecode instance, so destroy() neither
+        # waits for them nor pulls their memory out from under them
+        pyeclib_c.destroy(handle)
+        if pyeclib_c.get_liberasurecode_version() > 0x010604:
+            with self.assertRaises(ECBackendInstanceNotAvailable):
+                pyeclib_c.encode(handle, whole_file_bytes)
+        self.assertEqual(views, expected)
+        self.assertEqual(decoded, whole_file_bytes)
+
+        # Releasing the last of them gives the memory back through the
+        # instance, which only then goes away
+        tail = views[-1][-16:]
+        del views, decoded
+        self.assertEqual(tail, expected[-1][-16:])
+        del tail
+        if pyeclib_c.get_liberasurecode_version() > 0x010604:
+            with self.assertRaises(ECBackendInstanceNotAvailable):
+                pyeclib_c.destroy(handle)
+
+    def test_concurrent_use_of_one_handle(self):
+        # encode/decode/reconstruct drop the GIL while liberasurecode is
+        # working; results must not get mixed up between threads
+        handle = pyeclib_c.init(
+            4, 2, PyECLib_EC_Types.liberasurecode_rs_vand.value, 2
+        )
+        whole_file_bytes = self.get_tmp_file("101-K").read()
+        expected = pyeclib_c.encode(handle, whole_file_bytes)
+        fragment_len = len(expected[0])
+        failures = []
+
+        def worker(offset):
+            for _ in range(20):
+                fragments = pyeclib_c.encode(handle, whole_file_bytes)
+                if fragments != expected:
+                    failures.append("encode")
+                survivors = fragments[offset:] + fragments[:offset]
+                decoded = pyeclib_c.decode(
+                    handle, survivors[2:], fragment_len
+                )
+                if decoded != whole_file_bytes:
+                    failures.append("decode")
+                rebuilt = pyeclib_c.reconstruct(
+                    handle, survivors[1:], fragment_len, offset
+                )
+                if rebuilt != expected[offset]:
+                    failures.append("reconstruct")
+
+        threads = [
+            threading.Thread(target=worker, args=(i,)) for i in range(6)
+        ]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        self.assertEqual(failures, [])
+
+    def test_destroy_while_in_use(self):
+        # Run this under a free-threaded build as well: destroy() has to wait
+        # for calls already using the handle, and later calls must fail
+        # cleanly rather than touch a freed descriptor
+        if pyeclib_c.get_liberasurecode_version() <= 0x010604:
+            self.skipTest("liberasurecode can't report destroyed instances")
+        whole_file_bytes = self.get_tmp_file("101-K").read()
+        failures = []
+
+        def worker(handle, expected, start):
+            fragment_len = len(expected[0])
+            start.wait()
+            try:
+                while True:
+                    fragments = pyeclib_c.encode(handle, whole_file_bytes)
+                    if fragments != expected:
+                        failures.append("encode")
+                    decoded = pyeclib_c.decode(
+                        handle, fragments[2:], fragment_len
+                    )
+                    if decoded != whole_file_bytes:
+                        failures.append("decode")
+                    rebuilt = pyeclib_c.reconstruct(
+                        handle, fragments[1:], fragment_len, 0
+                    )
+                    if rebuilt != expected[0]:
+                        failures.append("reconstruct")
+            except ECBackendInstanceNotAvailable:
+                pass
+            except Exception as e:
+                failures.append(repr(e))
+
+        for delay in (0, 0.001, 0.01):
+            for _ in range(10):
+                handle = pyeclib_c.init(
+                    4, 2, PyECLib_EC_Types.liberasurecode_rs_vand.value, 2
+                )
+                expected = pyeclib_c.encode(handle, whole_file_bytes)
+                start = threading.Barrier(5)
+                threads = [
+                    threading.Thread(
+                        target=worker, args=(handle, expected, start)
+                    )
+                    for _ in range(4)
+                ]
+                for t in threads:
+                    t.start()
+                start.wait()
+                time.sleep(delay)
+                pyeclib_c.destroy(handle)
+                for t in threads:
+                    t.join()
+                with self.assertRaises(ECBackendInstanceNotAvailable):
+                    pyeclib_c.encode(handle, whole_file_bytes)
+        self.assertEqual(failures, [])
+
+
+class TestProbeNotes(unittest.TestCase):
+    # Probe name -> number of arguments, as documented in
+    # doc/source/tracing.rst: k, m and backend id, then the further arguments
+    documented = {
+        "encode_entry": 4,
+        "encode_return": 5,
+        "decode_entry": 6,
+        "decode_return": 6,
+        "reconstruct_entry": 6,
+        "reconstruct_return": 6,
+        "get_required_fragments_entry": 3,
+        "get_required_fragments_return": 6,
+        "check_metadata_entry": 4,
+        "check_metadata_return": 5,
+    }
+
+    def test_probes_match_documentation(self):
+        if not sys.platform.startswith("linux"):
+            self.skipTest("USDT probes are only built on Linux")
+        notes = read_stapsdt_notes(pyeclib_c.__file__)
+        if not notes:
+            self.skipTest("pyeclib_c was built without <sys/sdt.h>")
+        found = {}
+        for provider, name, arguments in notes:
+            self.assertEqual("pyeclib", provider)
+            # Every site of a probe must pass the same arguments
+            found.setdefault(name, set()).add(len(arguments))
+        self.assertEqual(
+            {name: {count} for name, count in self.documented.items()}, found
+        )
+
+
+@unittest.skipUnless(
+    shutil.which("bpftrace") and os.geteuid() == 0,
+    "attaching to USDT probes needs bpftrace and root",
+)
+class TestProbes(unittest.TestCase):
+
+    def setUp(self):
+        if not read_stapsdt_notes(pyeclib_c.__file__):
+            self.skipTest("pyeclib_c was built without <sys/sdt.h>")
+
+    def trace(self, probe, fmt, args, code):
+        script = 'usdt:%s:pyeclib:%s { printf("%s\\n", %s); }' % (
+            pyeclib_c.__file__,
+            probe,
+            fmt,
+            args,
+        )
+        with tempfile.NamedTemporaryFile("w", suffix=".py") as child:
+            child.write(code)
+            child.flush()
+            proc = subprocess.run(
+                [
+                    "bpftrace",
+                    "-e",
+                    script,
+                    "-c",
+                    "%s %s" % (sys.executable, child.name),
+                ],
+                stdout=subprocess.PIPE,
+                universal_newlines=True,
+                check=True,
+                timeout=120,
+            )
+        return [
+            line for line in proc.stdout.splitlines() if line[:1].isdigit()
+        ]
+
+    def test_decode_return_reports_payload_size(self):
+        # The payload can be read straight out of the data fragments, rebuilt
+        # from the parity, or sliced into ranges; every one of those decodes
+        # reports the size of the whole payload
+        code = "\n".join(
+            [
+                "import pyeclib_c",
+                "h = pyeclib_c.init(4, 2, %d, 2)"
+                % PyECLib_EC_Types.liberasurecode_rs_vand.value,
+                "f = pyeclib_c.encode(h, bytes(10000))",
+                "n = len(f[0])",
+                "pyeclib_c.decode(h, f, n)",
+                "pyeclib_c.decode(h, f[2:], n)",
+                "pyeclib_c.decode(h, f, n, [(0, 9), (100, 199)])",
+                "pyeclib_c.decode(h, f, n, None, True)",
+            ]
+        )
+        lines = self.trace(
+            "decode_return", "%d %d %d", "arg3, arg4, (int64)arg5", code
+        )
+        self.assertEqual(
+            lines, ["6 10000 0", "4 10000 0", "6 10000 0", "6 10000 0"]
+        )
+
 
 if __name__ == "__main__":
     unittest.main()
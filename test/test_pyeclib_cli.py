@@ -21,12 +21,17 @@
 # (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
 # THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
+import csv
 import io
+import json
+import os
 import platform
 import re
+import tempfile
 import unittest
 from unittest import mock
 
+from pyeclib.cli import bench
 from pyeclib.cli.__main__ import main
 from pyeclib import ec_iface
 
@@ -274,3 +279,198 @@ class TestCheck(unittest.TestCase):
         self.assertEqual("", stdout.getvalue())
         self.assertEqual("", stderr.getvalue())
         self.assertEqual(caught.exception.code, 2)
+
+
+class TestBench(unittest.TestCase):
+    def _bench(self, args):
+        with (
+            mock.patch("sys.stdout", new=io.StringIO()) as stdout,
+            self.assertRaises(SystemExit) as caught,
+        ):
+            main(
+                [
+                    "bench",
+                    "--ec-type=liberasurecode_rs_vand",
+                    "--segment-size=4096",
+                    "--iterations=20",
+                    "--warmup=2",
+                    "--threads=2",
+                ]
+                + args
+            )
+        return caught.exception.code, stdout.getvalue().splitlines()
+
+    def test_json_and_compare(self):
+        with tempfile.TemporaryDirectory() as tempdir:
+            path = os.path.join(tempdir, "baseline.json")
+            code, lines = self._bench([f"--json={path}"])
+            self.assertEqual(code, 0)
+            # encode and decode, each with 1 and 2 threads
+            self.assertEqual(len(lines), 5)
+            self.assertIn("p50 ", lines[1])
+            self.assertIn("p999 ", lines[1])
+            with open(path) as fp:
+                report = json.load(fp)
+            self.assertGreaterEqual(report["cpus"], 1)
+            self.assertEqual(
+                [(r["op"], r["threads"]) for r in report["results"]],
+                [("encode", 1), ("encode", 2), ("decode", 1), ("decode", 2)],
+            )
+            for result in report["results"]:
+                self.assertLessEqual(result["p50_us"], result["p99_us"])
+                self.assertLessEqual(result["p99_us"], result["p999_us"])
+
+            code, lines = self._bench([f"--compare={path}", "--tolerance=1e9"])
+            self.assertEqual(code, 0)
+            self.assertNotIn("REGRESSION", "\n".join(lines))
+
+            # Pretend the baseline was much faster
+            for result in report["results"]:
+                result["ops_per_s"] *= 1000
+            with open(path, "w") as fp:
+                json.dump(report, fp)
+            code, lines = self._bench([f"--compare={path}"])
+            self.assertEqual(code, 1)
+            self.assertEqual(sum("REGRESSION" in line for line in lines), 4)
+
+    def test_threads_beyond_cpus_are_flagged(self):
+        with mock.patch("pyeclib.cli.bench.usable_cpus", return_value=1):
+            code, lines = self._bench([])
+        self.assertEqual(code, 0)
+        flagged = [line for line in lines if "not a scaling result" in line]
+        self.assertEqual(len(flagged), 2)
+        for line in flagged:
+            self.assertIn(", 2T)", line)
+            self.assertTrue(line.endswith("[1 CPU(s): not a scaling result]"))
+
+    def test_sweep(self):
+        with tempfile.TemporaryDirectory() as tempdir:
+            path = os.path.join(tempdir, "sweep.csv")
+            code, lines = self._bench(
+                [
+                    "--threads=1",
+                    "--n-parity=2",
+                    "--sweep=k=2,4",
+                    "--sweep=unavailable=1,3",
+                    "--sweep=op=" + ",".join(bench.OPERATIONS),
+                    f"--csv={path}",
+                ]
+            )
+            self.assertEqual(code, 0)
+            with open(path, newline="") as fp:
+                rows = list(csv.DictReader(fp))
+        # m=2 can't lose 3 frags
+        self.assertEqual(
+            [(row["k"], row["unavailable"]) for row in rows],
+            [("2", "1")] * 6 + [("4", "1")] * 6,
+        )
+        self.assertEqual(
+            [row["op"] for row in rows], list(bench.OPERATIONS) * 2
+        )
+        self.assertIn(
+            "liberasurecode_rs_vand k=2 unavailable=3: more unavailable "
+            "frags than parity",
+            lines,
+        )
+        fastest = lines.index("Fastest:")
+        self.assertEqual(len(lines[fastest + 1 :]), len(bench.OPERATIONS))
+
+    def test_overhead(self):
+        with tempfile.TemporaryDirectory() as tempdir:
+            path = os.path.join(tempdir, "overhead.json")
+            code, lines = self._bench(
+                [
+                    "--overhead",
+                    "--sweep=op=encode,decode,reconstruct,segment_info",
+                    f"--json={path}",
+                ]
+            )
+            self.assertEqual(code, 0)
+            with open(path) as fp:
+                results = json.load(fp)["results"]
+        self.assertEqual(
+            [r["op"] for r in results], ["encode", "decode", "reconstruct"]
+        )
+        for result in results:
+            self.assertGreater(result["native_us"], 0)
+            self.assertAlmostEqual(
+                result["overhead_us"],
+                result["binding_us"] - result["native_us"],
+            )
+        self.assertIn(
+            "liberasurecode_rs_vand (segment_info): no native baseline", lines
+        )
+        self.assertTrue(
+            any(line.startswith("Native baseline: ") for line in lines)
+        )
+
+class TestScan(unittest.TestCase):
+    def setUp(self):
+        self.tempdir = tempfile.TemporaryDirectory()
+        self.addCleanup(self.tempdir.cleanup)
+        driver = ec_iface.ECDriver(
+            ec_type="liberasurecode_rs_vand",
+            k=4,
+            m=2,
+            chksum_type="inline_crc32",
+        )
+        self.fragments = [
+            driver.encode(os.urandom(10000))[1] for _ in range(3)
+        ]
+        self.archive = b"".join(self.fragments)
+
+    def _write(self, name, data):
+        path = os.path.join(self.tempdir.name, name)
+        with open(path, "wb") as fp:
+            fp.write(data)
+        return path
+
+    def _scan(self, args):
+        with (
+            mock.patch("sys.stdout", new=io.StringIO()) as stdout,
+            self.assertRaises(SystemExit) as caught,
+        ):
+            main(["scan"] + args)
+        return caught.exception.code, stdout.getvalue().splitlines()
+
+    def test_scan_ok(self):
+        path = self._write("good", self.archive)
+        code, lines = self._scan([path])
+        self.assertEqual(code, 0)
+        self.assertEqual(len(lines), 2)
+        self.assertTrue(lines[0].startswith(f"{path}: 3 fragments, "))
+        self.assertTrue(lines[0].endswith(", ok"))
+        self.assertTrue(lines[1].startswith("Scanned 1 files, "))
+
+        code, lines = self._scan(["-q", path])
+        self.assertEqual((code, lines), (0, []))
+
+    def test_scan_bad(self):
+        corrupt = bytearray(self.archive)
+        corrupt[len(self.fragments[0]) + 100] ^= 0xFF
+        paths = [
+            self._write("corrupt", corrupt),
+            self._write("truncated", self.archive[:-1]),
+        ]
+        code, lines = self._scan(["-q"] + paths)
+        self.assertEqual(code, 1)
+        self.assertEqual(len(lines), 2)
+        self.assertIn(
+            f"1 bad at offsets {len(self.fragments[0])}", lines[0]
+        )
+        self.assertIn(
+            "unparseable data at offset "
+            f"{len(self.fragments[0]) + len(self.fragments[1])}",
+            lines[1],
+        )
+
+        # Without checksum verification only the truncation shows up
+        code, lines = self._scan(["-q", "--headers-only"] + paths)
+        self.assertEqual((code, len(lines)), (1, 1))
+
+    def test_scan_missing(self):
+        missing = os.path.join(self.tempdir.name, "missing")
+        code, lines = self._scan(["-q", missing])
+        self.assertEqual(code, 2)
+        self.assertEqual(len(lines), 1)
+        self.assertTrue(lines[0].startswith(f"{missing}: "))